@@ -2,10 +2,11 @@
 
 #include "Env.h"
 #include "log.h"
+#include <chrono>
+#include <functional>
 #include <jsi/jsi.h>
 #include <memory>
 #include <string>
-#include <thread>
 #include <vector>
 #include <atomic>
 
@@ -15,25 +16,36 @@ namespace onnxruntimereactnativejsi {
 
 class AsyncWorker : public HostObject, public std::enable_shared_from_this<AsyncWorker> {
 public:
-  AsyncWorker(Runtime &rt, std::shared_ptr<Env> env) : rt_(rt), env_(env), cancel_(false) {}
-
-  ~AsyncWorker() {
-    if (worker_.joinable()) {
-      if (worker_.get_id() != std::this_thread::get_id()) {
-        cancel_ = true;
-        onAbort();
-        worker_.join();
-      } else {
-        worker_.detach();
-      }
-    }
-  }
+  AsyncWorker(Runtime &rt, std::shared_ptr<Env> env,
+              std::shared_ptr<WorkerPool::SerialQueue> queue = nullptr)
+      : rt_(rt), env_(env), queue_(queue), cancel_(false),
+        requestId_(TraceBuffer::newRequestId()),
+        createdAt_(std::chrono::steady_clock::now()) {}
 
   void keepValue(Runtime &rt, const Value &value) {
     keptValues_.push_back(std::make_shared<Value>(rt, value));
   }
 
+  // Stops the task: one still queued is rejected with "Aborted" without
+  // running, and a running execute() is asked to stop through onAbort().
+  // The promise settles either way. Must be called from the JS thread.
+  void abort() {
+    if (settled_ || cancel_) {
+      return;
+    }
+    cancel_ = true;
+    onAbort();
+  }
+
+  // Whether the promise has settled. JS thread only.
+  bool settled() const { return settled_; }
+
   Value toPromise(Runtime &rt) {
+    auto &trace = env_->getTrace();
+    TraceSpan span(trace, "toPromise", requestId_);
+    // Arguments were converted while constructing the worker.
+    trace.record("marshalInputs", createdAt_,
+                 std::chrono::steady_clock::now(), requestId_);
     auto promiseCtor = rt.global().getPropertyAsFunction(rt, "Promise");
 
     auto promise = promiseCtor.callAsConstructor(
@@ -41,18 +53,57 @@ public:
                 rt, PropNameID::forAscii(rt, "executor"), 2,
                 [this](Runtime &rt, const Value &thisVal, const Value *args,
                        size_t count) -> Value {
+                  if (rejectWhenFull_ &&
+                      priority_ != WorkerPool::Priority::High &&
+                      env_->isQueueFull()) {
+                    // Settled through onReject like any other failure, so
+                    // subclasses can undo their bookkeeping.
+                    settled_ = true;
+                    auto reason = onReject(rt, "Run queue is full");
+                    args[1].asObject(rt).asFunction(rt).call(rt, reason);
+                    clearKeeps();
+                    return Value::undefined();
+                  }
                   resolveFunc_ = std::make_shared<Value>(rt, args[0]);
                   rejectFunc_ = std::make_shared<Value>(rt, args[1]);
-                  cancel_ = false;
-                  worker_ = std::thread([this]() {
-                    if (cancel_) return;
+                  queuedAt_ = std::chrono::steady_clock::now();
+                  // The task owns the worker until it settles, so the
+                  // promise settles even if JS drops every reference to it.
+                  // The reference is handed back to the JS thread with the
+                  // result and released there.
+                  auto task = shared_from_this();
+                  env_->getWorkerPool().submit(queue_, [task]() mutable {
+                    auto self = std::move(task);
+                    if (self->cancel_) {
+                      dispatchReject(std::move(self), "Aborted");
+                      return;
+                    }
+                    auto now = std::chrono::steady_clock::now();
+                    self->startedAt_ = now;
+                    auto &trace = self->env_->getTrace();
+                    trace.record("queue", self->queuedAt_, now,
+                                 self->requestId_, TraceBuffer::Kind::Async);
+                    self->queueWaitMs_ =
+                        std::chrono::duration<double, std::milli>(
+                            now - self->queuedAt_)
+                            .count();
+                    if (now > self->deadline_) {
+                      self->expired_ = true;
+                      dispatchReject(std::move(self),
+                                     "Deadline exceeded while queued");
+                      return;
+                    }
                     try {
-                      execute();
-                      dispatchResolve();
+                      self->execute();
                     } catch (const std::exception &e) {
-                      dispatchReject(e.what());
+                      dispatchReject(std::move(self), e.what());
+                      return;
                     }
-                  });
+                    self->executedAt_ = std::chrono::steady_clock::now();
+                    trace.record("execute", now, self->executedAt_,
+                                 self->requestId_);
+                    dispatchResolve(std::move(self));
+                  }, priority_);
                   return Value::undefined();
                 }));
     promise.asObject(rt).setProperty(rt, "__nativeWorker", Object::createFromHostObject(rt, shared_from_this()));
@@ -67,23 +118,138 @@ protected:
     return String::createFromUtf8(rt, err);
   }
 
+  // Called from abort() on the JS thread, possibly while execute() runs on
+  // a pool thread; asks execute() to return early, e.g. by terminating ORT.
   virtual void onAbort() {}
 
-private:
-  void dispatchResolve() {
-    if (cancel_) return;
+  // Reads the scheduling fields of run options, which may be null:
+  // `priority` ('high', 'normal' or 'low') and `deadlineMs`, the longest the
+  // task may wait in the queue before it is rejected unrun. Workers calling
+  // this are also rejected up front when the Env's queue is full, unless
+  // they are high priority.
+  void parseScheduling(Runtime &rt, const Value *options) {
+    rejectWhenFull_ = true;
+    if (!options || !options->isObject()) {
+      return;
+    }
+    auto object = options->asObject(rt);
+    auto priority = object.getProperty(rt, "priority");
+    if (priority.isString()) {
+      auto name = priority.asString(rt).utf8(rt);
+      if (name == "high") {
+        priority_ = WorkerPool::Priority::High;
+      } else if (name == "normal") {
+        priority_ = WorkerPool::Priority::Normal;
+      } else if (name == "low") {
+        priority_ = WorkerPool::Priority::Low;
+      } else {
+        throw JSError(rt, "Unknown priority: " + name);
+      }
+    }
+    auto deadline = object.getProperty(rt, "deadlineMs");
+    if (deadline.isNumber()) {
+      deadline_ = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(
+                      static_cast<int64_t>(deadline.asNumber() * 1000));
+    }
+  }
+
+  // Time between toPromise() and the start of execute().
+  double queueWaitMs() const { return queueWaitMs_; }
+
+  // Reads the `timings` run option, which may be null.
+  void parseTimings(Runtime &rt, const Value *options) {
+    if (options && options->isObject()) {
+      auto timings = options->asObject(rt).getProperty(rt, "timings");
+      timingsEnabled_ = timings.isBool() && timings.asBool();
+    }
+  }
+
+  bool timingsEnabled() const { return timingsEnabled_; }
+
+  // Whether the task was rejected without running, past its deadline.
+  bool expired() const { return expired_; }
+
+  // Whether abort() was called.
+  bool aborted() const { return cancel_; }
+
+  // Time spent on the JS thread converting arguments before toPromise()
+  // and, from onResolve(), results so far.
+  double marshalMs() const {
+    auto ms = std::chrono::duration<double, std::milli>(queuedAt_ - createdAt_)
+                  .count();
+    if (dispatchedAt_ != std::chrono::steady_clock::time_point()) {
+      ms += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - dispatchedAt_)
+                .count();
+    }
+    return ms;
+  }
+
+  // Breakdown of the worker's life so far, for the end of onResolve():
+  //   marshalMs  construction up to toPromise(), i.e. converting arguments
+  //   queueMs    waiting for a pool thread
+  //   runMs      the given time spent inside ORT
+  //   executeMs  all of execute(), runMs included
+  //   jsWaitMs   waiting for the JS thread once execute() finished
+  //   outputMs   onResolve() so far, i.e. converting results
+  //   totalMs    construction until now
+  Object createTimings(Runtime &rt, double runMs) const {
+    auto now = std::chrono::steady_clock::now();
+    auto ms = [](std::chrono::steady_clock::time_point from,
+                 std::chrono::steady_clock::time_point to) {
+      return std::chrono::duration<double, std::milli>(to - from).count();
+    };
+    auto timings = Object(rt);
+    timings.setProperty(rt, "marshalMs", ms(createdAt_, queuedAt_));
+    timings.setProperty(rt, "queueMs", queueWaitMs_);
+    timings.setProperty(rt, "runMs", runMs);
+    timings.setProperty(rt, "executeMs", ms(startedAt_, executedAt_));
+    timings.setProperty(rt, "jsWaitMs", ms(executedAt_, dispatchedAt_));
+    timings.setProperty(rt, "outputMs", ms(dispatchedAt_, now));
+    timings.setProperty(rt, "totalMs", ms(createdAt_, now));
+    return timings;
+  }
+
+  // Runs func on the JS thread, e.g. to report progress from execute().
+  // Calls are delivered in order and before the promise settles, and are
+  // dropped once the worker is aborted.
+  void runOnJsThread(std::function<void(Runtime &)> &&func) {
     auto self = shared_from_this();
-    env_->runOnJsThread([self]() {
+    env_->runOnJsThread([self = std::move(self), func = std::move(func)]() {
+      if (self->cancel_) return;
+      func(self->rt_);
+    });
+  }
+
+private:
+  // Both take over the caller's reference so the worker is always released
+  // on the JS thread, never on a pool thread.
+  static void dispatchResolve(std::shared_ptr<AsyncWorker> self) {
+    auto env = self->env_;
+    env->runOnJsThread([self = std::move(self)]() {
+      self->settled_ = true;
+      self->dispatchedAt_ = std::chrono::steady_clock::now();
+      auto &trace = self->env_->getTrace();
+      trace.record("invokeAsync", self->executedAt_, self->dispatchedAt_,
+                   self->requestId_, TraceBuffer::Kind::Async);
+      TraceSpan span(trace, "resolve", self->requestId_);
       auto resVal = self->onResolve(self->rt_);
       self->resolveFunc_->asObject(self->rt_).asFunction(self->rt_).call(self->rt_, resVal);
       self->clearKeeps();
     });
   }
 
-  void dispatchReject(const std::string &err) {
-    if (cancel_) return;
-    auto self = shared_from_this();
-    env_->runOnJsThread([self, err]() {
+  static void dispatchReject(std::shared_ptr<AsyncWorker> self,
+                             const std::string &err) {
+    auto env = self->env_;
+    auto failedAt = std::chrono::steady_clock::now();
+    env->runOnJsThread([self = std::move(self), err, failedAt]() {
+      self->settled_ = true;
+      auto &trace = self->env_->getTrace();
+      trace.record("invokeAsync", failedAt, std::chrono::steady_clock::now(),
+                   self->requestId_, TraceBuffer::Kind::Async);
+      TraceSpan span(trace, "reject", self->requestId_);
       auto resVal = self->onReject(self->rt_, err);
       self->rejectFunc_->asObject(self->rt_).asFunction(self->rt_).call(self->rt_, resVal);
       self->clearKeeps();
@@ -98,8 +264,25 @@ private:
 
   Runtime &rt_;
   std::shared_ptr<Env> env_;
+  std::shared_ptr<WorkerPool::SerialQueue> queue_;
+  // Set by abort(); read from the pool thread.
   std::atomic<bool> cancel_;
-  std::thread worker_;
+  // Only touched on the JS thread.
+  bool settled_ = false;
+  WorkerPool::Priority priority_ = WorkerPool::Priority::Normal;
+  bool rejectWhenFull_ = false;
+  bool timingsEnabled_ = false;
+  bool expired_ = false;
+  // Ties this worker's trace spans together.
+  uint64_t requestId_;
+  std::chrono::steady_clock::time_point createdAt_;
+  std::chrono::steady_clock::time_point queuedAt_;
+  std::chrono::steady_clock::time_point startedAt_;
+  std::chrono::steady_clock::time_point executedAt_;
+  std::chrono::steady_clock::time_point dispatchedAt_;
+  std::chrono::steady_clock::time_point deadline_ =
+      std::chrono::steady_clock::time_point::max();
+  double queueWaitMs_ = 0;
   std::vector<std::shared_ptr<Value>> keptValues_;
   std::shared_ptr<Value> resolveFunc_;
   std::shared_ptr<Value> rejectFunc_;
@@ -1,15 +1,76 @@
 #pragma once
 
+#include "SessionRegistry.h"
+#include "TraceBuffer.h"
+#include "WorkerPool.h"
 #include <ReactCommon/CallInvoker.h>
 #include <algorithm>
 #include <functional>
 #include <jsi/jsi.h>
 #include <memory>
 #include <onnxruntime_cxx_api.h>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace onnxruntimereactnativejsi {
 
+// JSI handles reused when marshalling tensors, so hot paths don't rebuild
+// property names or look up globals on every call.
+struct JsiCache {
+  explicit JsiCache(facebook::jsi::Runtime &runtime)
+      : cpuData(facebook::jsi::PropNameID::forAscii(runtime, "cpuData")),
+        dims(facebook::jsi::PropNameID::forAscii(runtime, "dims")),
+        type(facebook::jsi::PropNameID::forAscii(runtime, "type")),
+        buffer(facebook::jsi::PropNameID::forAscii(runtime, "buffer")),
+        byteOffset(facebook::jsi::PropNameID::forAscii(runtime, "byteOffset")),
+        byteLength(
+            facebook::jsi::PropNameID::forAscii(runtime, "byteLength")) {}
+
+  facebook::jsi::PropNameID cpuData;
+  facebook::jsi::PropNameID dims;
+  facebook::jsi::PropNameID type;
+  facebook::jsi::PropNameID buffer;
+  facebook::jsi::PropNameID byteOffset;
+  facebook::jsi::PropNameID byteLength;
+  // Indexed by ONNXTensorElementDataType, filled on first use.
+  std::vector<std::unique_ptr<facebook::jsi::Function>> typedArrayConstructors;
+  std::vector<std::unique_ptr<facebook::jsi::String>> typeNames;
+};
+
+// ORT thread pools shared by every session created with
+// useGlobalThreadPools, instead of each session starting its own.
+struct GlobalThreadPoolOptions {
+  // 0 lets ORT pick, one intra-op thread per physical core.
+  int intraOpNumThreads = 0;
+  int interOpNumThreads = 0;
+  // Whether idle pool threads spin before sleeping.
+  bool allowSpinning = true;
+  // Processor affinity in ORT's intra_op_thread_affinities format, e.g.
+  // "1;2;3" for four threads. Empty leaves scheduling to the OS.
+  std::string intraOpThreadAffinity;
+};
+
+// A CPU arena registered with the ORT Env, which sessions created with
+// useSharedArena allocate from instead of each growing its own. -1 leaves
+// a setting at ORT's default.
+struct SharedArenaOptions {
+  // Upper bound of the arena in bytes; 0 for no limit.
+  size_t maxMemory = 0;
+  // 0 grows by powers of two, 1 by what each request needs.
+  int extendStrategy = -1;
+  int initialChunkSizeBytes = -1;
+  // Unused bytes a chunk may keep before it is split.
+  int maxDeadBytesPerChunk = -1;
+};
+
+// A session handed out to JS, for memory reports.
+struct LiveSession {
+  std::shared_ptr<Ort::Session> session;
+  // Whether it allocates from the Env's shared arena.
+  bool sharedArena;
+};
+
 class Env : public std::enable_shared_from_this<Env> {
 public:
   Env(std::shared_ptr<facebook::react::CallInvoker> jsInvoker)
@@ -17,11 +78,43 @@ public:
 
   ~Env() {}
 
-  inline void initOrtEnv(OrtLoggingLevel logLevel, const char *logid) {
+  // threadPools creates the global thread pools and sharedArena the shared
+  // CPU arena; neither can be added later.
+  inline void initOrtEnv(OrtLoggingLevel logLevel, const char *logid,
+                         const GlobalThreadPoolOptions *threadPools = nullptr,
+                         const SharedArenaOptions *sharedArena = nullptr) {
     if (ortEnv_) {
       return;
     }
-    ortEnv_ = std::make_shared<Ort::Env>(logLevel, logid);
+    if (threadPools) {
+      Ort::ThreadingOptions threadingOptions;
+      threadingOptions.SetGlobalIntraOpNumThreads(
+          threadPools->intraOpNumThreads);
+      threadingOptions.SetGlobalInterOpNumThreads(
+          threadPools->interOpNumThreads);
+      threadingOptions.SetGlobalSpinControl(threadPools->allowSpinning ? 1
+                                                                       : 0);
+      if (!threadPools->intraOpThreadAffinity.empty()) {
+        Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpThreadAffinity(
+            threadingOptions, threadPools->intraOpThreadAffinity.c_str()));
+      }
+      ortEnv_ = std::make_shared<Ort::Env>(threadingOptions, logLevel, logid);
+      globalThreadPools_ =
+          std::make_unique<GlobalThreadPoolOptions>(*threadPools);
+    } else {
+      ortEnv_ = std::make_shared<Ort::Env>(logLevel, logid);
+    }
+    if (sharedArena) {
+      Ort::ArenaCfg arenaCfg(sharedArena->maxMemory,
+                             sharedArena->extendStrategy,
+                             sharedArena->initialChunkSizeBytes,
+                             sharedArena->maxDeadBytesPerChunk);
+      auto memoryInfo =
+          Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+      ortEnv_->CreateAndRegisterAllocator(memoryInfo, arenaCfg);
+      hasSharedArena_ = true;
+    }
+    prepackedWeights_ = std::make_unique<Ort::PrepackedWeightsContainer>();
   }
 
   inline void setTensorConstructor(
@@ -39,15 +132,145 @@ public:
 
   inline Ort::Env &getOrtEnv() const { return *ortEnv_; }
 
+  // Options the global thread pools were created with, or null without them.
+  inline const GlobalThreadPoolOptions *getGlobalThreadPools() const {
+    return globalThreadPools_.get();
+  }
+
+  inline bool hasSharedArena() const { return hasSharedArena_; }
+
+  // Holds the weights CPU kernels prepack, for sessions created with it, so
+  // sessions over the same weights keep one prepacked copy between them.
+  // ORT synchronizes access to it.
+  inline Ort::PrepackedWeightsContainer &getPrepackedWeights() const {
+    return *prepackedWeights_;
+  }
+
+  // Initializers sessions can share by name instead of each loading its own
+  // copy. A null value removes the name; sessions already using the value
+  // keep it alive. Must be called from the JS thread.
+  inline void setSharedInitializer(const std::string &name,
+                                   std::shared_ptr<Ort::Value> value) {
+    if (value) {
+      sharedInitializers_[name] = std::move(value);
+    } else {
+      sharedInitializers_.erase(name);
+    }
+  }
+
+  // Must be called from the JS thread.
+  inline std::shared_ptr<Ort::Value>
+  getSharedInitializer(const std::string &name) const {
+    auto it = sharedInitializers_.find(name);
+    return it != sharedInitializers_.end() ? it->second : nullptr;
+  }
+
+  // Must be called from the JS thread.
+  inline const std::unordered_map<std::string, std::shared_ptr<Ort::Value>> &
+  getSharedInitializers() const {
+    return sharedInitializers_;
+  }
+
+  // Remembers a session for memory reports until it is released. Must be
+  // called from the JS thread.
+  inline void trackSession(const std::shared_ptr<Ort::Session> &session,
+                           bool sharedArena) {
+    pruneSessions();
+    liveSessions_.push_back({session, sharedArena});
+  }
+
+  // Each live session once, including idle ones kept by the registry. Must
+  // be called from the JS thread.
+  inline std::vector<LiveSession> getLiveSessions() {
+    pruneSessions();
+    std::vector<LiveSession> sessions;
+    for (const auto &tracked : liveSessions_) {
+      auto session = tracked.session.lock();
+      if (session &&
+          std::none_of(sessions.begin(), sessions.end(),
+                       [&](const LiveSession &live) {
+                         return live.session == session;
+                       })) {
+        sessions.push_back({std::move(session), tracked.sharedArena});
+      }
+    }
+    return sessions;
+  }
+
+  // Sizes the shared worker pool. Only effective before the pool is first
+  // used; later calls keep the existing threads.
+  inline void initWorkerPool(size_t size) {
+    if (workerPool_) {
+      return;
+    }
+    workerPool_ = std::make_unique<WorkerPool>(
+        size > 0 ? size : WorkerPool::defaultSize());
+  }
+
+  // Must be called from the JS thread.
+  inline WorkerPool &getWorkerPool() {
+    if (!workerPool_) {
+      initWorkerPool(0);
+    }
+    return *workerPool_;
+  }
+
+  // Must be called from the JS thread. Env is installed per runtime, so the
+  // cache is tied to that runtime like the tensor constructor.
+  inline JsiCache &getJsiCache(facebook::jsi::Runtime &runtime) {
+    if (!jsiCache_) {
+      jsiCache_ = std::make_unique<JsiCache>(runtime);
+    }
+    return *jsiCache_;
+  }
+
+  inline SessionRegistry &getSessionRegistry() { return sessionRegistry_; }
+
+  // Binding spans; recording is a no-op until tracing is started.
+  inline TraceBuffer &getTrace() { return trace_; }
+
+  // 0 means unbounded.
+  inline void setMaxQueueDepth(size_t depth) { maxQueueDepth_ = depth; }
+
+  // Must be called from the JS thread.
+  inline bool isQueueFull() {
+    return maxQueueDepth_ > 0 && getWorkerPool().pending() >= maxQueueDepth_;
+  }
+
   inline void runOnJsThread(std::function<void()> &&func) {
     if (!jsInvoker_) return;
     jsInvoker_->invokeAsync(std::move(func));
   }
 
 private:
+  struct TrackedSession {
+    std::weak_ptr<Ort::Session> session;
+    bool sharedArena;
+  };
+
+  inline void pruneSessions() {
+    liveSessions_.erase(
+        std::remove_if(liveSessions_.begin(), liveSessions_.end(),
+                       [](const TrackedSession &tracked) {
+                         return tracked.session.expired();
+                       }),
+        liveSessions_.end());
+  }
+
   std::shared_ptr<facebook::react::CallInvoker> jsInvoker_;
   std::shared_ptr<facebook::jsi::WeakObject> tensorConstructor_;
   std::shared_ptr<Ort::Env> ortEnv_;
+  std::unique_ptr<Ort::PrepackedWeightsContainer> prepackedWeights_;
+  std::unique_ptr<GlobalThreadPoolOptions> globalThreadPools_;
+  bool hasSharedArena_ = false;
+  std::unordered_map<std::string, std::shared_ptr<Ort::Value>>
+      sharedInitializers_;
+  std::vector<TrackedSession> liveSessions_;
+  std::unique_ptr<WorkerPool> workerPool_;
+  std::unique_ptr<JsiCache> jsiCache_;
+  SessionRegistry sessionRegistry_;
+  TraceBuffer trace_;
+  size_t maxQueueDepth_ = 0;
 };
 
 } // namespace onnxruntimereactnativejsi
@@ -1,60 +1,169 @@
 #include "InferenceSessionHostObject.h"
 #include "AsyncWorker.h"
+#include "IoBindingHostObject.h"
 #include "JsiUtils.h"
+#include "MappedFile.h"
+#include "ModelCache.h"
+#include "OrtValueHostObject.h"
+#include "ProfileSummary.h"
+#include "Sampler.h"
 #include "SessionUtils.h"
+#include "Sha256.h"
 #include "TensorUtils.h"
+#include "log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sys/stat.h>
 
 using namespace facebook::jsi;
 
 namespace onnxruntimereactnativejsi {
 
 InferenceSessionHostObject::InferenceSessionHostObject(std::shared_ptr<Env> env)
-    : env_(env), methods_({
-                     METHOD_INFO(InferenceSessionHostObject, loadModel, 2),
-                     METHOD_INFO(InferenceSessionHostObject, run, 2),
-                     METHOD_INFO(InferenceSessionHostObject, dispose, 0),
-                     METHOD_INFO(InferenceSessionHostObject, endProfiling, 0),
-                 }),
-      getters_({
-          GETTER_INFO(InferenceSessionHostObject, inputMetadata),
-          GETTER_INFO(InferenceSessionHostObject, outputMetadata),
-      }) {}
-
-std::vector<PropNameID>
-InferenceSessionHostObject::getPropertyNames(Runtime &rt) {
-  std::vector<PropNameID> names;
-  for (auto &[name, _] : methods_) {
-    names.push_back(PropNameID::forUtf8(rt, name));
-  }
-  for (auto &[name, _] : getters_) {
-    names.push_back(PropNameID::forUtf8(rt, name));
-  }
-  return names;
+    : JsiHostObject(
+          {
+              METHOD_INFO(InferenceSessionHostObject, loadModel, 4),
+              METHOD_INFO(InferenceSessionHostObject, run, 2),
+              METHOD_INFO(InferenceSessionHostObject, dispose, 0),
+              METHOD_INFO(InferenceSessionHostObject, endProfiling, 0),
+              METHOD_INFO(InferenceSessionHostObject, startProfiling, 0),
+              METHOD_INFO(InferenceSessionHostObject, stopProfiling, 1),
+              METHOD_INFO(InferenceSessionHostObject, createBinding, 0),
+              METHOD_INFO(InferenceSessionHostObject, validateFeeds, 1),
+              METHOD_INFO(InferenceSessionHostObject, generate, 3),
+              METHOD_INFO(InferenceSessionHostObject, setBatching, 1),
+              METHOD_INFO(InferenceSessionHostObject, resetStats, 0),
+              METHOD_INFO(InferenceSessionHostObject, getMemoryReport, 0),
+          },
+          {
+              GETTER_INFO(InferenceSessionHostObject, inputMetadata),
+              GETTER_INFO(InferenceSessionHostObject, outputMetadata),
+              GETTER_INFO(InferenceSessionHostObject, warmupMs),
+              GETTER_INFO(InferenceSessionHostObject, stats),
+          }),
+      env_(env), queue_(std::make_shared<WorkerPool::SerialQueue>()),
+      memoryInfo_(
+          Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)),
+      stats_(std::make_shared<SessionStats>()) {}
+
+InferenceSessionHostObject::~InferenceSessionHostObject() {
+  session_.reset();
+  env_->getSessionRegistry().trim();
 }
 
-Value InferenceSessionHostObject::get(Runtime &runtime,
-                                      const PropNameID &name) {
-  auto propName = name.utf8(runtime);
-  auto method = methods_.find(propName);
-  if (method != methods_.end()) {
-    return Function::createFromHostFunction(runtime, name, method->second.count,
-                                            method->second.method);
+void InferenceSessionHostObject::setSession(
+    std::shared_ptr<Ort::Session> session,
+    std::shared_ptr<const ModelMetadata> metadata) {
+  session_ = session;
+  if (session_) {
+    env_->trackSession(session_, sharedArena_);
+  }
+  // The replaced session may now be idle in the registry.
+  env_->getSessionRegistry().trim();
+  metadata_ = metadata;
+  profilingWindowUs_ = 0;
+  profilingEnded_ = false;
+  inputIndices_.clear();
+  outputIndices_.clear();
+  runPlans_.clear();
+  jsInputMetadata_.reset();
+  jsOutputMetadata_.reset();
+  if (!metadata_) {
+    return;
   }
+  for (size_t i = 0; i < metadata_->inputs.size(); ++i) {
+    inputIndices_.emplace(metadata_->inputs[i].name, i);
+  }
+  for (size_t i = 0; i < metadata_->outputs.size(); ++i) {
+    outputIndices_.emplace(metadata_->outputs[i].name, i);
+  }
+}
 
-  auto getter = getters_.find(propName);
-  if (getter != getters_.end()) {
-    return getter->second(runtime);
+// Only a miss reads the names back out of the signature, so a run whose
+// plan is cached builds nothing but the signature itself.
+std::shared_ptr<const InferenceSessionHostObject::RunPlan>
+InferenceSessionHostObject::getRunPlan(Runtime &runtime,
+                                       const std::string &signature) {
+  auto cached = runPlans_.find(signature);
+  if (cached != runPlans_.end()) {
+    return cached->second;
   }
 
-  return Value::undefined();
+  auto plan = std::make_shared<RunPlan>();
+  bool fetches = false;
+  size_t start = 0;
+  for (size_t i = 0; i < signature.size(); ++i) {
+    if (signature[i] == '\1') {
+      fetches = true;
+      start = i + 1;
+      continue;
+    }
+    if (signature[i] != '\0') {
+      continue;
+    }
+    auto name = signature.substr(start, i - start);
+    start = i + 1;
+    auto &indices = fetches ? outputIndices_ : inputIndices_;
+    auto it = indices.find(name);
+    if (it == indices.end()) {
+      throw JSError(runtime, (fetches ? "Unknown output name: "
+                                      : "Unknown input name: ") +
+                                 name);
+    }
+    (fetches ? plan->outputIndices : plan->inputIndices)
+        .push_back(it->second);
+  }
+  // Point into the session's interned names; the plan keeps them alive.
+  plan->metadata = metadata_;
+  for (auto index : plan->inputIndices) {
+    plan->inputNames.push_back(plan->metadata->inputs[index].name.c_str());
+  }
+  for (auto index : plan->outputIndices) {
+    plan->outputNames.push_back(plan->metadata->outputs[index].name.c_str());
+  }
+
+  if (runPlans_.size() >= kMaxRunPlans) {
+    runPlans_.clear();
+  }
+  runPlans_.emplace(signature, plan);
+  return plan;
 }
 
-void InferenceSessionHostObject::set(Runtime &runtime, const PropNameID &name,
-                                     const Value &value) {
-  auto propName = name.utf8(runtime);
-  auto setter = setters_.find(propName);
-  if (setter != setters_.end()) {
-    setter->second(runtime, value);
+// Checks a feed against the cached metadata of model input `index`, so shape
+// and type mismatches are reported before any work is queued.
+void InferenceSessionHostObject::validateInput(
+    Runtime &runtime, size_t index, ONNXTensorElementDataType type,
+    const std::vector<int64_t> &shape) {
+  const auto &metadata = metadata_->inputs[index];
+  if (!metadata.isTensor) {
+    return;
+  }
+  if (type != metadata.type) {
+    throw JSError(runtime,
+                  "Unexpected type for input " + metadata.name +
+                      ": expected " +
+                      std::to_string(static_cast<int>(metadata.type)) +
+                      ", got " + std::to_string(static_cast<int>(type)));
+  }
+  if (shape.size() != metadata.shape.size()) {
+    throw JSError(runtime, "Unexpected rank for input " + metadata.name +
+                               ": expected " +
+                               std::to_string(metadata.shape.size()) +
+                               ", got " + std::to_string(shape.size()));
+  }
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (metadata.shape[i] >= 0 && shape[i] != metadata.shape[i]) {
+      throw JSError(runtime, "Unexpected size for input " + metadata.name +
+                                 " dimension " + std::to_string(i) +
+                                 ": expected " +
+                                 std::to_string(metadata.shape[i]) + ", got " +
+                                 std::to_string(shape[i]));
+    }
   }
 }
 
@@ -62,9 +171,13 @@ class InferenceSessionHostObject::LoadModelAsyncWorker : public AsyncWorker {
 public:
   LoadModelAsyncWorker(Runtime &runtime, const Value *arguments, size_t count,
                        std::shared_ptr<InferenceSessionHostObject> session)
-      : AsyncWorker(runtime, session->env_), session_(session) {
+      : AsyncWorker(runtime, session->env_, session->queue_),
+        session_(session) {
     if (count < 1)
       throw JSError(runtime, "loadModel requires at least 1 argument");
+    // loadModel(path, options) or loadModel(buffer, byteOffset, byteLength,
+    // options)
+    size_t optionsIndex = 1;
     if (arguments[0].isString()) {
       modelPath_ = arguments[0].asString(runtime).utf8(runtime);
       if (modelPath_.find("file://") == 0) {
@@ -74,80 +187,476 @@ public:
                arguments[0].asObject(runtime).isArrayBuffer(runtime)) {
       auto arrayBufferObj = arguments[0].asObject(runtime);
       auto arrayBuffer = arrayBufferObj.getArrayBuffer(runtime);
-      modelData_ = arrayBuffer.data(runtime);
-      modelDataLength_ = arrayBuffer.size(runtime);
+      size_t bufferSize = arrayBuffer.size(runtime);
+      size_t byteOffset = 0;
+      size_t byteLength = bufferSize;
+      if (count > 1 && arguments[1].isNumber()) {
+        byteOffset = static_cast<size_t>(arguments[1].asNumber());
+      }
+      if (count > 2 && arguments[2].isNumber()) {
+        byteLength = static_cast<size_t>(arguments[2].asNumber());
+      } else {
+        byteLength = bufferSize - std::min(byteOffset, bufferSize);
+      }
+      if (byteOffset > bufferSize || byteLength > bufferSize - byteOffset) {
+        throw JSError(runtime, "Model buffer view is out of bounds");
+      }
+      modelData_ = arrayBuffer.data(runtime) + byteOffset;
+      modelDataLength_ = byteLength;
+      optionsIndex = 3;
     } else {
       throw JSError(runtime, "Model path or buffer is required");
     }
     keepValue(runtime, arguments[0]);
-    if (count > 1) {
-      parseSessionOptions(runtime, arguments[1], sessionOptions_);
+    if (count > optionsIndex) {
+      // External data buffers are only read when the session is created.
+      keepValue(runtime, arguments[optionsIndex]);
+      parseSessionOptions(runtime, *session->env_, arguments[optionsIndex],
+                          sessionOptions_, resources_);
+      sharedArena_ = resources_.sharedArena;
+      parseCacheOptions(runtime, arguments[optionsIndex]);
+      parseWarmupOptions(runtime, arguments[optionsIndex]);
     }
+    parseRegistryKey(runtime, count > optionsIndex ? &arguments[optionsIndex]
+                                                   : nullptr);
   }
 
 protected:
   void execute() {
-    if (modelPath_.empty()) {
-      session_->session_ = std::make_shared<Ort::Session>(
-          session_->env_->getOrtEnv(), modelData_, modelDataLength_,
-          sessionOptions_);
-    } else {
-      session_->session_ = std::make_shared<Ort::Session>(
-          session_->env_->getOrtEnv(), modelPath_.c_str(), sessionOptions_);
+    auto &registry = session_->env_->getSessionRegistry();
+    if (!registryKey_.empty()) {
+      registryKey_ += modelPath_.empty()
+                          ? std::to_string(modelDataLength_) + ":" +
+                                contentDigest()
+                          : MappedFile::fileIdentity(modelPath_);
+      ortSession_ = registry.acquire(registryKey_);
+    }
+    if (!ortSession_) {
+      ortSession_ = loadSession();
+      if (!registryKey_.empty()) {
+        ortSession_ = registry.insert(registryKey_, ortSession_, footprint_);
+      }
+    }
+    Ort::AllocatorWithDefaultOptions allocator;
+    auto metadata = std::make_shared<ModelMetadata>();
+    for (size_t i = 0; i < ortSession_->GetInputCount(); ++i) {
+      metadata->inputs.push_back(readMetadata(
+          ortSession_->GetInputNameAllocated(i, allocator).get(),
+          ortSession_->GetInputTypeInfo(i)));
+    }
+    for (size_t i = 0; i < ortSession_->GetOutputCount(); ++i) {
+      metadata->outputs.push_back(readMetadata(
+          ortSession_->GetOutputNameAllocated(i, allocator).get(),
+          ortSession_->GetOutputTypeInfo(i)));
+    }
+    metadata_ = metadata;
+    if (warmupIterations_ > 0) {
+      warmup(*metadata);
+    }
+    if (aborted()) {
+      throw std::runtime_error("Aborted");
     }
   }
 
-  Value onResolve(Runtime &rt) { return Value::undefined(); }
+  Value onResolve(Runtime &rt) {
+    // Disposed after execute() checked: the session is dropped, not
+    // installed, so it can leave the registry.
+    if (aborted()) {
+      ortSession_.reset();
+      session_->env_->getSessionRegistry().trim();
+      return Value::undefined();
+    }
+    session_->sharedArena_ = sharedArena_;
+    session_->setSession(ortSession_, metadata_);
+    session_->warmupMs_ = std::move(warmupMs_);
+    return Value::undefined();
+  }
 
 private:
+  std::shared_ptr<Ort::Session> loadSession() {
+    std::unique_ptr<Ort::Session> ortSession;
+    if (isOrtFormat(modelPath_)) {
+      // ORT-format models are used straight from the mapping: the session
+      // reads the flatbuffer and its initializers in place instead of
+      // copying them, so only the pages actually touched become resident.
+      auto model = std::make_shared<MappedFile>(modelPath_);
+      sessionOptions_.AddConfigEntry("session.use_ort_model_bytes_directly",
+                                     "1");
+      sessionOptions_.AddConfigEntry(
+          "session.use_ort_model_bytes_for_initializers", "1");
+      ortSession = createSession(nullptr, model->data(), model->size(),
+                                 sessionOptions_);
+      resources_.mappedFiles.push_back(model);
+    } else if (!cacheDirectory_.empty()) {
+      ortSession = createCachedSession();
+    } else if (modelPath_.empty()) {
+      ortSession = createSession(nullptr, modelData_, modelDataLength_,
+                                 sessionOptions_);
+    } else {
+      ortSession =
+          createSession(modelPath_.c_str(), nullptr, 0, sessionOptions_);
+    }
+    // The session may point into mapped files and shared initializers, so
+    // they are released together with it.
+    footprint_ = estimateFootprint();
+    auto resources = std::make_shared<SessionResources>(std::move(resources_));
+    return std::shared_ptr<Ort::Session>(
+        ortSession.release(),
+        [resources](Ort::Session *session) { delete session; });
+  }
+
+  // warmup: true, an iteration count, or {iterations, dims}, where dims
+  // sizes symbolic dimensions by name.
+  void parseWarmupOptions(Runtime &runtime, const Value &optionsValue) {
+    if (!optionsValue.isObject()) {
+      return;
+    }
+    auto option = optionsValue.asObject(runtime).getProperty(runtime, "warmup");
+    if (option.isBool()) {
+      warmupIterations_ = option.asBool() ? 1 : 0;
+    } else if (option.isNumber()) {
+      warmupIterations_ = static_cast<size_t>(std::max(0.0, option.asNumber()));
+    } else if (option.isObject()) {
+      auto object = option.asObject(runtime);
+      auto iterations = object.getProperty(runtime, "iterations");
+      warmupIterations_ =
+          iterations.isNumber()
+              ? static_cast<size_t>(std::max(0.0, iterations.asNumber()))
+              : 1;
+      auto dims = object.getProperty(runtime, "dims");
+      if (dims.isObject()) {
+        forEach(runtime, dims.asObject(runtime),
+                [&](const std::string &name, const Value &value, size_t) {
+                  if (value.isNumber()) {
+                    warmupDims_[name] = static_cast<int64_t>(value.asNumber());
+                  }
+                });
+      }
+    }
+  }
+
+  // Runs all-zero inputs through the new session, so arena growth, memory
+  // planning and lazy kernel setup happen before the first real run.
+  // Dynamic dimensions are sized from warmup.dims by name, or 1.
+  void warmup(const ModelMetadata &metadata) {
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<const char *> inputNames;
+    std::vector<Ort::Value> inputs;
+    for (const auto &input : metadata.inputs) {
+      if (!input.isTensor) {
+        throw std::runtime_error("Warm-up requires tensor inputs, " +
+                                 input.name + " is not a tensor");
+      }
+      auto shape = input.shape;
+      for (size_t i = 0; i < shape.size(); ++i) {
+        if (shape[i] >= 0) {
+          continue;
+        }
+        auto dim = i < input.symbolicDimensions.size()
+                       ? warmupDims_.find(input.symbolicDimensions[i])
+                       : warmupDims_.end();
+        shape[i] = dim != warmupDims_.end() ? dim->second : 1;
+      }
+      inputNames.push_back(input.name.c_str());
+      inputs.push_back(
+          TensorUtils::createZeroTensor(shape, input.type, allocator));
+    }
+    std::vector<const char *> outputNames;
+    for (const auto &output : metadata.outputs) {
+      outputNames.push_back(output.name.c_str());
+    }
+    Ort::RunOptions runOptions;
+    for (size_t i = 0; i < warmupIterations_; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      ortSession_->Run(runOptions, inputNames.data(), inputs.data(),
+                       inputs.size(), outputNames.data(), outputNames.size());
+      warmupMs_.push_back(std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+    }
+  }
+
+  // Sessions are shared through the Env's registry unless shareSession is
+  // false. They are keyed by the model path with its size and modification
+  // time, or by the buffer's length and SHA-256, both added in execute, and
+  // the options as JSON. Options whose native
+  // state the key cannot capture opt out: TypedArray external data,
+  // initializers registered by name, and profiling, which is per session.
+  void parseRegistryKey(Runtime &runtime, const Value *optionsValue) {
+    std::string options;
+    if (optionsValue && optionsValue->isObject()) {
+      auto object = optionsValue->asObject(runtime);
+      auto share = object.getProperty(runtime, "shareSession");
+      auto profiling = object.getProperty(runtime, "enableProfiling");
+      if ((share.isBool() && !share.asBool()) ||
+          (profiling.isBool() && profiling.asBool()) ||
+          !resources_.initializers.empty() ||
+          hasInMemoryExternalData(runtime, object)) {
+        return;
+      }
+      auto json = runtime.global()
+                      .getPropertyAsObject(runtime, "JSON")
+                      .getPropertyAsFunction(runtime, "stringify")
+                      .call(runtime, *optionsValue);
+      if (json.isString()) {
+        options = json.asString(runtime).utf8(runtime);
+      }
+    }
+    registryKey_ = options + (modelPath_.empty() ? "\nbuffer:" : "\npath:") +
+                   modelPath_ + "\n";
+  }
+
+  static bool hasInMemoryExternalData(Runtime &runtime,
+                                      const Object &options) {
+    auto externalData = options.getProperty(runtime, "externalData");
+    if (!externalData.isObject() ||
+        !externalData.asObject(runtime).isArray(runtime)) {
+      return false;
+    }
+    bool inMemory = false;
+    forEach(runtime, externalData.asObject(runtime).asArray(runtime),
+            [&](const Value &entry, size_t index) {
+              if (entry.isObject() && !entry.asObject(runtime)
+                                           .getProperty(runtime, "data")
+                                           .isString()) {
+                inMemory = true;
+              }
+            });
+    return inMemory;
+  }
+
+  // Bytes of the model and mapped external data, as a stand-in for the
+  // session's footprint, which ORT does not report.
+  size_t estimateFootprint() const {
+    size_t bytes = modelPath_.empty() ? modelDataLength_ : 0;
+    if (!modelPath_.empty() && !isOrtFormat(modelPath_)) {
+      struct stat st;
+      if (stat(modelPath_.c_str(), &st) == 0) {
+        bytes += static_cast<size_t>(st.st_size);
+      }
+    }
+    for (const auto &file : resources_.mappedFiles) {
+      bytes += file->size();
+    }
+    return bytes;
+  }
+
+  // optimizedModelCacheDir only applies to self-contained models run on the
+  // CPU: graphs partitioned for other providers may not serialize, and
+  // external weights are not part of the cache key.
+  void parseCacheOptions(Runtime &runtime, const Value &optionsValue) {
+    if (!optionsValue.isObject()) {
+      return;
+    }
+    auto options = optionsValue.asObject(runtime);
+    auto directory = options.getProperty(runtime, "optimizedModelCacheDir");
+    if (!directory.isString() || isOrtFormat(modelPath_) ||
+        !options.getProperty(runtime, "externalData").isUndefined() ||
+        !resources_.initializers.empty()) {
+      return;
+    }
+    auto providers = options.getProperty(runtime, "executionProviders");
+    if (providers.isObject() && providers.asObject(runtime).isArray(runtime)) {
+      bool cpuOnly = true;
+      forEach(runtime, providers.asObject(runtime).asArray(runtime),
+              [&](const Value &provider, size_t index) {
+                auto name = provider.isObject()
+                                ? provider.asObject(runtime).getProperty(
+                                      runtime, "name")
+                                : Value(runtime, provider);
+                cpuOnly = cpuOnly && name.isString() &&
+                          name.asString(runtime).utf8(runtime) == "cpu";
+              });
+      if (!cpuOnly) {
+        return;
+      }
+    }
+    // Options that change the optimized graph; the rest only affect how it
+    // runs.
+    auto stringify = runtime.global()
+                         .getPropertyAsObject(runtime, "JSON")
+                         .getPropertyAsFunction(runtime, "stringify");
+    for (auto name : {"graphOptimizationLevel", "freeDimensionOverrides"}) {
+      auto json = stringify.call(runtime, options.getProperty(runtime, name));
+      cacheFingerprint_ += name;
+      cacheFingerprint_ += '=';
+      if (json.isString()) {
+        cacheFingerprint_ += json.asString(runtime).utf8(runtime);
+      }
+      cacheFingerprint_ += '\n';
+    }
+    cacheDirectory_ =
+        MappedFile::toPath(directory.asString(runtime).utf8(runtime));
+  }
+
+  // Loads the cached optimized model with optimizations off, or creates the
+  // session normally and has ORT write the optimized model to the cache.
+  std::unique_ptr<Ort::Session> createCachedSession() {
+    auto cache = modelPath_.empty()
+                     ? ModelCache::forBuffer(cacheDirectory_, contentDigest(),
+                                             cacheFingerprint_)
+                     : ModelCache::forFile(cacheDirectory_, modelPath_,
+                                           cacheFingerprint_);
+    if (cache.hasEntry()) {
+      try {
+        auto options = sessionOptions_.Clone();
+        options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+        return createSession(cache.entryPath().c_str(), nullptr, 0, options);
+      } catch (const Ort::Exception &e) {
+        LOGE("Discarding unloadable cached model %s: %s",
+             cache.entryPath().c_str(), e.what());
+        cache.discard();
+      }
+    }
+    auto options = sessionOptions_.Clone();
+    options.SetOptimizedModelFilePath(cache.pendingPath().c_str());
+    auto path = modelPath_.empty() ? nullptr : modelPath_.c_str();
+    std::unique_ptr<Ort::Session> ortSession;
+    try {
+      ortSession = createSession(path, modelData_, modelDataLength_, options);
+    } catch (const Ort::Exception &) {
+      // Most likely the optimized model could not be saved; load uncached.
+      std::remove(cache.pendingPath().c_str());
+      return createSession(path, modelData_, modelDataLength_,
+                           sessionOptions_);
+    }
+    cache.commit();
+    return ortSession;
+  }
+
+  // SHA-256 of a buffer model, computed at most once per load.
+  const std::string &contentDigest() {
+    if (contentDigest_.empty()) {
+      contentDigest_ = sha256Hex(modelData_, modelDataLength_);
+    }
+    return contentDigest_;
+  }
+
+  // Creates the session from path, or from data when path is null.
+  std::unique_ptr<Ort::Session>
+  createSession(const char *path, const void *data, size_t size,
+                const Ort::SessionOptions &options) {
+    auto &env = *session_->env_;
+    if (resources_.sharePrepackedWeights) {
+      OrtPrepackedWeightsContainer *container = env.getPrepackedWeights();
+      return path ? std::make_unique<Ort::Session>(env.getOrtEnv(), path,
+                                                   options, container)
+                  : std::make_unique<Ort::Session>(env.getOrtEnv(), data,
+                                                   size, options, container);
+    }
+    return path ? std::make_unique<Ort::Session>(env.getOrtEnv(), path,
+                                                 options)
+                : std::make_unique<Ort::Session>(env.getOrtEnv(), data, size,
+                                                 options);
+  }
+
+  static bool isOrtFormat(const std::string &path) {
+    static const std::string extension = ".ort";
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(),
+                        extension) == 0;
+  }
+
   std::string error_;
   std::string modelPath_;
-  void *modelData_;
+  uint8_t *modelData_;
   size_t modelDataLength_;
+  std::string contentDigest_;
   std::shared_ptr<InferenceSessionHostObject> session_;
+  std::shared_ptr<Ort::Session> ortSession_;
+  std::shared_ptr<const ModelMetadata> metadata_;
   Ort::SessionOptions sessionOptions_;
+  SessionResources resources_;
+  std::string registryKey_;
+  size_t footprint_ = 0;
+  // Read from resources_ up front, which loadSession() hands to the session.
+  bool sharedArena_ = false;
+  size_t warmupIterations_ = 0;
+  std::unordered_map<std::string, int64_t> warmupDims_;
+  std::vector<double> warmupMs_;
+  std::string cacheDirectory_;
+  std::string cacheFingerprint_;
+
+  static ValueMetadata readMetadata(const char *name,
+                                    const Ort::TypeInfo &typeInfo) {
+    ValueMetadata metadata;
+    metadata.name = name;
+    try {
+      auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
+      metadata.isTensor = true;
+      metadata.type = tensorInfo.GetElementType();
+      metadata.shape = tensorInfo.GetShape();
+      for (auto dim : tensorInfo.GetSymbolicDimensions()) {
+        metadata.symbolicDimensions.emplace_back(dim);
+      }
+    } catch (const std::exception &) {
+      // Fallback for unknown types
+      metadata.isTensor = false;
+      metadata.type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+    }
+    return metadata;
+  }
 };
 
 DEFINE_METHOD(InferenceSessionHostObject::loadModel) {
   auto self = shared_from_this();
   auto worker =
       std::make_shared<LoadModelAsyncWorker>(runtime, arguments, count, self);
+  trackWorker(worker);
   return worker->toPromise(runtime);
 }
 
 class InferenceSessionHostObject::RunAsyncWorker : public AsyncWorker {
 public:
-  RunAsyncWorker(
-    Runtime &runtime,
-    const Value *arguments,
-    size_t count,
-    std::shared_ptr<Env> env,
-    std::shared_ptr<Ort::Session> session
-  )
-      : AsyncWorker(runtime, env),
-        env_(env),
-        session_(session),
-        memoryInfo_(
-            Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)) {
+  RunAsyncWorker(Runtime &runtime, const Value *arguments, size_t count,
+                 std::shared_ptr<InferenceSessionHostObject> session)
+      : AsyncWorker(runtime, session->env_, session->queue_),
+        env_(session->env_), session_(session->session_),
+        stats_(session->stats_) {
     if (count < 1)
       throw JSError(runtime, "run requires at least 1 argument");
+    if (!session->session_)
+      throw JSError(runtime, "Session is not loaded");
     if (count > 2 && !arguments[2].isUndefined()) {
       parseRunOptions(runtime, arguments[2], runOptions_);
     }
+    parseScheduling(runtime, count > 2 ? &arguments[2] : nullptr);
+    parseTimings(runtime, count > 2 ? &arguments[2] : nullptr);
+    const auto &memoryInfo = session->memoryInfo_;
+    auto &signature = session->runSignature_;
+    signature.clear();
     forEach(runtime, arguments[0].asObject(runtime),
             [&](const std::string &key, const Value &value, size_t index) {
-              inputNames_.push_back(key);
-              inputValues_.push_back(TensorUtils::createOrtValueFromJSTensor(
-                  runtime, value.asObject(runtime), memoryInfo_));
-              keepValue(runtime, value);
+              signature.append(key).push_back('\0');
+              auto nativeValue = value.isObject()
+                                     ? OrtValueHostObject::getValue(
+                                           runtime, value.asObject(runtime))
+                                     : nullptr;
+              if (nativeValue) {
+                inputValues_.push_back(
+                    TensorUtils::createOrtValueView(*nativeValue, memoryInfo));
+                nativeInputs_.push_back(nativeValue);
+              } else {
+                inputValues_.push_back(TensorUtils::createOrtValueFromJSTensor(
+                    runtime, *env_, value.asObject(runtime), memoryInfo));
+                keepValue(runtime, value);
+                bytesIn_ += TensorUtils::getByteLength(inputValues_.back());
+              }
             });
+    signature.push_back('\1');
     forEach(runtime, arguments[1].asObject(runtime),
             [&](const std::string &key, const Value &value, size_t index) {
-              outputNames_.push_back(key);
-              if (value.isObject() &&
-                  TensorUtils::isTensor(runtime, value.asObject(runtime))) {
+              signature.append(key).push_back('\0');
+              nativeOutputs_.push_back(value.isString() &&
+                                       value.asString(runtime).utf8(runtime) ==
+                                           "native");
+              auto tensor = value.isObject()
+                                ? TensorUtils::readTensor(
+                                      runtime, *env_, value.asObject(runtime))
+                                : JSTensorProperties();
+              if (tensor.isTensor()) {
                 outputValues_.push_back(TensorUtils::createOrtValueFromJSTensor(
-                    runtime, value.asObject(runtime), memoryInfo_));
+                    runtime, *env_, tensor, memoryInfo));
                 jsOutputValues_.push_back(std::make_shared<WeakObject>(
                     runtime, value.asObject(runtime)));
                 keepValue(runtime, value);
@@ -156,67 +665,881 @@ public:
                 jsOutputValues_.push_back(nullptr);
               }
             });
+    plan_ = session->getRunPlan(runtime, signature);
+    for (size_t i = 0; i < inputValues_.size(); ++i) {
+      auto info = inputValues_[i].GetTensorTypeAndShapeInfo();
+      session->validateInput(runtime, plan_->inputIndices[i],
+                             info.GetElementType(), info.GetShape());
+    }
   }
 
 protected:
   void execute() {
-    auto inputNames = std::vector<const char *>(inputNames_.size());
-    std::transform(inputNames_.begin(), inputNames_.end(), inputNames.begin(),
-                   [](const std::string &name) { return name.c_str(); });
-    auto outputNames = std::vector<const char *>(outputNames_.size());
-    std::transform(outputNames_.begin(), outputNames_.end(),
-                   outputNames.begin(),
-                   [](const std::string &name) { return name.c_str(); });
     auto session = session_.lock();
     if (!session) {
       throw std::runtime_error("Session is released");
     }
-    session->Run(runOptions_, inputNames.data(), inputValues_.data(),
-                 inputValues_.size(), outputNames.data(),
+    auto start = std::chrono::steady_clock::now();
+    session->Run(runOptions_, plan_->inputNames.data(), inputValues_.data(),
+                 inputValues_.size(), plan_->outputNames.data(),
                  outputValues_.data(), outputValues_.size());
+    runMs_ = std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
   }
 
   Value onResolve(Runtime &rt) {
     auto resultObject = Object(rt);
     auto tensorConstructor =
         env_->getTensorConstructor(rt).asObject(rt);
+    size_t bytesOut = 0;
     for (size_t i = 0; i < outputValues_.size(); ++i) {
       if (jsOutputValues_[i] != nullptr && outputValues_[i].IsTensor()) {
-        resultObject.setProperty(rt, outputNames_[i].c_str(),
+        resultObject.setProperty(rt, plan_->outputNames[i],
                                  jsOutputValues_[i]->lock(rt));
+      } else if (nativeOutputs_[i] && isNativeTensor(outputValues_[i])) {
+        auto hostObject = std::make_shared<OrtValueHostObject>(
+            env_, std::make_shared<Ort::Value>(std::move(outputValues_[i])));
+        resultObject.setProperty(rt, plan_->outputNames[i],
+                                 Object::createFromHostObject(rt, hostObject));
       } else {
+        bytesOut += TensorUtils::getByteLength(outputValues_[i]);
         auto tensorObj = TensorUtils::createJSTensorFromOrtValue(
-            rt, outputValues_[i], tensorConstructor);
-        resultObject.setProperty(rt, outputNames_[i].c_str(),
+            rt, *env_, outputValues_[i], tensorConstructor);
+        resultObject.setProperty(rt, plan_->outputNames[i],
                                  Value(rt, tensorObj));
       }
     }
+    defineHiddenProperty(rt, resultObject, "queueWaitMs", queueWaitMs());
+    if (timingsEnabled()) {
+      defineHiddenProperty(rt, resultObject, "timings",
+                           createTimings(rt, runMs_));
+    }
+    stats_->queueMs.record(queueWaitMs());
+    stats_->runMs.record(runMs_);
+    stats_->marshalMs.record(marshalMs());
+    stats_->bytesIn.fetch_add(bytesIn_, std::memory_order_relaxed);
+    stats_->bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+    stats_->runs.fetch_add(1, std::memory_order_relaxed);
     return Value(rt, resultObject);
   }
 
+  Value onReject(Runtime &rt, const std::string &err) {
+    (expired() || aborted() ? stats_->cancels : stats_->errors)
+        .fetch_add(1, std::memory_order_relaxed);
+    return AsyncWorker::onReject(rt, err);
+  }
+
+  // Makes a run in progress return early with an error.
   void onAbort() {
     runOptions_.SetTerminate();
   }
 
+  // String tensors are not kept native since their data cannot be viewed
+  // or fed back without a copy.
+  static bool isNativeTensor(const Ort::Value &value) {
+    return value.IsTensor() &&
+           value.GetTensorTypeAndShapeInfo().GetElementType() !=
+               ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING;
+  }
+
 private:
   std::shared_ptr<Env> env_;
   std::weak_ptr<Ort::Session> session_;
-  Ort::MemoryInfo memoryInfo_;
+  std::shared_ptr<const RunPlan> plan_;
   Ort::RunOptions runOptions_;
-  std::vector<std::string> inputNames_;
   std::vector<Ort::Value> inputValues_;
-  std::vector<std::string> outputNames_;
   std::vector<Ort::Value> outputValues_;
   std::vector<std::shared_ptr<WeakObject>> jsOutputValues_;
+  // Keeps fed native tensors alive even if disposed during the run.
+  std::vector<std::shared_ptr<Ort::Value>> nativeInputs_;
+  std::vector<bool> nativeOutputs_;
+  double runMs_ = 0;
+  std::shared_ptr<SessionStats> stats_;
+  size_t bytesIn_ = 0;
+};
+
+// run() calls coalesced into one session->Run. Inputs are concatenated and
+// outputs split along batching_.axis.
+struct InferenceSessionHostObject::RunBatch {
+  struct Request {
+    std::shared_ptr<Value> resolve;
+    std::shared_ptr<Value> reject;
+    // The JS tensors the input views point into.
+    std::vector<std::shared_ptr<Value>> feeds;
+    std::vector<Ort::Value> inputs;
+    std::vector<Ort::Value> outputs;
+  };
+
+  std::string signature;
+  std::shared_ptr<const RunPlan> plan;
+  size_t axis;
+  // Shapes of the first request; later ones may only differ along axis.
+  std::vector<std::vector<int64_t>> shapes;
+  std::vector<int64_t> sizes;
+  int64_t totalSize = 0;
+  std::vector<Request> requests;
+
+  bool accepts(const std::string &otherSignature,
+               const std::vector<std::vector<int64_t>> &otherShapes) const {
+    if (otherSignature != signature) {
+      return false;
+    }
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      for (size_t d = 0; d < shapes[i].size(); ++d) {
+        if (d != axis && shapes[i][d] != otherShapes[i][d]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+class InferenceSessionHostObject::BatchRunAsyncWorker : public AsyncWorker {
+public:
+  BatchRunAsyncWorker(Runtime &runtime, std::shared_ptr<RunBatch> batch,
+                      std::shared_ptr<InferenceSessionHostObject> session)
+      : AsyncWorker(runtime, session->env_, session->queue_),
+        env_(session->env_), session_(session->session_),
+        stats_(session->stats_), batch_(batch) {}
+
+protected:
+  // Never throws, so the worker's own promise always resolves; failures are
+  // reported to each request in onResolve.
+  void execute() {
+    try {
+      auto session = session_.lock();
+      if (!session) {
+        throw std::runtime_error("Session is released");
+      }
+      auto &requests = batch_->requests;
+      const auto &plan = *batch_->plan;
+      for (const auto &request : requests) {
+        for (const auto &input : request.inputs) {
+          bytesIn_ += TensorUtils::getByteLength(input);
+        }
+      }
+      std::vector<Ort::Value> inputs;
+      if (requests.size() == 1) {
+        inputs = std::move(requests[0].inputs);
+      } else {
+        Ort::AllocatorWithDefaultOptions allocator;
+        std::vector<const Ort::Value *> parts(requests.size());
+        for (size_t i = 0; i < plan.inputNames.size(); ++i) {
+          for (size_t r = 0; r < requests.size(); ++r) {
+            parts[r] = &requests[r].inputs[i];
+          }
+          inputs.push_back(
+              TensorUtils::concatTensors(parts, batch_->axis, allocator));
+        }
+      }
+
+      std::vector<Ort::Value> outputs(plan.outputNames.size());
+      auto start = std::chrono::steady_clock::now();
+      session->Run(runOptions_, plan.inputNames.data(),
+                   inputs.data(), inputs.size(), plan.outputNames.data(),
+                   outputs.data(), outputs.size());
+      runMs_ = std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+
+      if (requests.size() == 1) {
+        requests[0].outputs = std::move(outputs);
+      } else {
+        Ort::AllocatorWithDefaultOptions allocator;
+        for (auto &output : outputs) {
+          auto parts = TensorUtils::splitTensor(output, batch_->axis,
+                                                batch_->sizes, allocator);
+          for (size_t r = 0; r < requests.size(); ++r) {
+            requests[r].outputs.push_back(std::move(parts[r]));
+          }
+        }
+      }
+    } catch (const std::exception &e) {
+      error_ = e.what();
+    }
+  }
+
+  Value onResolve(Runtime &rt) {
+    const auto &plan = *batch_->plan;
+    auto tensorConstructor = env_->getTensorConstructor(rt).asObject(rt);
+    // Each request counts as a run; all share the batch's queue and run time.
+    stats_->bytesIn.fetch_add(bytesIn_, std::memory_order_relaxed);
+    for (auto &request : batch_->requests) {
+      if (!error_.empty()) {
+        stats_->errors.fetch_add(1, std::memory_order_relaxed);
+        request.reject->asObject(rt).asFunction(rt).call(
+            rt, String::createFromUtf8(rt, error_));
+        continue;
+      }
+      stats_->queueMs.record(queueWaitMs());
+      stats_->runMs.record(runMs_);
+      stats_->runs.fetch_add(1, std::memory_order_relaxed);
+      auto resultObject = Object(rt);
+      for (size_t i = 0; i < request.outputs.size(); ++i) {
+        stats_->bytesOut.fetch_add(
+            TensorUtils::getByteLength(request.outputs[i]),
+            std::memory_order_relaxed);
+        auto tensorObj = TensorUtils::createJSTensorFromOrtValue(
+            rt, *env_, request.outputs[i], tensorConstructor);
+        resultObject.setProperty(rt, plan.outputNames[i], tensorObj);
+      }
+      defineHiddenProperty(rt, resultObject, "queueWaitMs", queueWaitMs());
+      request.resolve->asObject(rt).asFunction(rt).call(rt, resultObject);
+    }
+    batch_->requests.clear();
+    return Value::undefined();
+  }
+
+  // Only reached when the batch is aborted before it runs.
+  Value onReject(Runtime &rt, const std::string &err) {
+    for (auto &request : batch_->requests) {
+      stats_->cancels.fetch_add(1, std::memory_order_relaxed);
+      request.reject->asObject(rt).asFunction(rt).call(
+          rt, String::createFromUtf8(rt, err));
+    }
+    batch_->requests.clear();
+    return AsyncWorker::onReject(rt, err);
+  }
+
+  void onAbort() { runOptions_.SetTerminate(); }
+
+private:
+  std::shared_ptr<Env> env_;
+  std::weak_ptr<Ort::Session> session_;
+  std::shared_ptr<SessionStats> stats_;
+  std::shared_ptr<RunBatch> batch_;
+  Ort::RunOptions runOptions_;
+  std::string error_;
+  double runMs_ = 0;
+  size_t bytesIn_ = 0;
 };
 
+// Only plain JS tensor feeds with ORT-allocated fetches and default run
+// options are batched; anything else runs on its own.
+bool InferenceSessionHostObject::canBatch(Runtime &runtime,
+                                          const Value *arguments,
+                                          size_t count) {
+  if (batching_.maxBatchSize < 2 || count < 2 || !arguments[0].isObject() ||
+      !arguments[1].isObject()) {
+    return false;
+  }
+  if (count > 2 && !arguments[2].isUndefined()) {
+    return false;
+  }
+  bool batchable = true;
+  forEach(runtime, arguments[0].asObject(runtime),
+          [&](const std::string &key, const Value &value, size_t index) {
+            batchable = batchable && value.isObject() &&
+                        !OrtValueHostObject::getValue(runtime,
+                                                      value.asObject(runtime));
+          });
+  forEach(runtime, arguments[1].asObject(runtime),
+          [&](const std::string &key, const Value &value, size_t index) {
+            batchable = batchable && (value.isNull() || value.isUndefined());
+          });
+  return batchable;
+}
+
+// Whether every fetched output has the inputs' batch dimension at
+// batching_.axis, so a batched result can be split back per call. Only a
+// dimension the model names alike in every input and output is trusted; a
+// fixed or unnamed one may not be the batch.
+bool InferenceSessionHostObject::outputsFollowBatch(
+    const RunPlan &plan) const {
+  auto axis = batching_.axis;
+  const std::string *batchDim = nullptr;
+  for (auto index : plan.inputIndices) {
+    const auto &dims = plan.metadata->inputs[index].symbolicDimensions;
+    if (axis >= dims.size() || dims[axis].empty() ||
+        (batchDim && *batchDim != dims[axis])) {
+      return false;
+    }
+    batchDim = &dims[axis];
+  }
+  if (!batchDim) {
+    return false;
+  }
+  for (auto index : plan.outputIndices) {
+    const auto &dims = plan.metadata->outputs[index].symbolicDimensions;
+    if (axis >= dims.size() || dims[axis] != *batchDim) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Value InferenceSessionHostObject::enqueueBatchedRun(Runtime &runtime,
+                                                   const Value *arguments,
+                                                   size_t count) {
+  // Backpressure is applied per call; the batch itself is never rejected.
+  // Like an unbatched run, a rejected call gets a rejected promise.
+  if (env_->isQueueFull()) {
+    stats_->errors.fetch_add(1, std::memory_order_relaxed);
+    auto promiseCtor =
+        runtime.global().getPropertyAsFunction(runtime, "Promise");
+    return promiseCtor.getPropertyAsFunction(runtime, "reject")
+        .callWithThis(runtime, promiseCtor,
+                      String::createFromUtf8(runtime, "Run queue is full"));
+  }
+  RunBatch::Request request;
+  auto &signature = runSignature_;
+  signature.clear();
+  std::vector<std::vector<int64_t>> shapes;
+  forEach(runtime, arguments[0].asObject(runtime),
+          [&](const std::string &key, const Value &value, size_t index) {
+            signature.append(key).push_back('\0');
+            request.feeds.push_back(std::make_shared<Value>(runtime, value));
+          });
+  signature.push_back('\1');
+  forEach(runtime, arguments[1].asObject(runtime),
+          [&](const std::string &key, const Value &value, size_t index) {
+            signature.append(key).push_back('\0');
+          });
+  auto plan = getRunPlan(runtime, signature);
+  if (!outputsFollowBatch(*plan)) {
+    auto worker = std::make_shared<RunAsyncWorker>(runtime, arguments, count,
+                                                   shared_from_this());
+    trackWorker(worker);
+    return worker->toPromise(runtime);
+  }
+
+  int64_t size = -1;
+  for (size_t i = 0; i < request.feeds.size(); ++i) {
+    request.inputs.push_back(TensorUtils::createOrtValueFromJSTensor(
+        runtime, *env_, request.feeds[i]->asObject(runtime), memoryInfo_));
+    auto info = request.inputs[i].GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    validateInput(runtime, plan->inputIndices[i], info.GetElementType(),
+                  shape);
+    if (info.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+      throw JSError(runtime, "String inputs cannot be batched");
+    }
+    if (batching_.axis >= shape.size()) {
+      const auto &name = plan->metadata->inputs[plan->inputIndices[i]].name;
+      throw JSError(runtime, "Input " + name + " has no batch dimension " +
+                                 std::to_string(batching_.axis));
+    }
+    if (size >= 0 && shape[batching_.axis] != size) {
+      throw JSError(runtime, "Inputs disagree on the batch size");
+    }
+    size = shape[batching_.axis];
+    shapes.push_back(std::move(shape));
+  }
+
+  if (pendingBatch_ && !pendingBatch_->accepts(signature, shapes)) {
+    flushBatch(runtime);
+  }
+  if (!pendingBatch_) {
+    pendingBatch_ = std::make_shared<RunBatch>();
+    pendingBatch_->signature = signature;
+    pendingBatch_->plan = plan;
+    pendingBatch_->axis = batching_.axis;
+    pendingBatch_->shapes = shapes;
+    std::weak_ptr<InferenceSessionHostObject> weakSelf = shared_from_this();
+    std::weak_ptr<RunBatch> weakBatch = pendingBatch_;
+    auto setTimeout = runtime.global().getPropertyAsFunction(runtime,
+                                                             "setTimeout");
+    setTimeout.call(
+        runtime,
+        Function::createFromHostFunction(
+            runtime, PropNameID::forAscii(runtime, "flushBatch"), 0,
+            [weakSelf, weakBatch](Runtime &rt, const Value &thisVal,
+                                  const Value *args, size_t count) -> Value {
+              auto self = weakSelf.lock();
+              auto batch = weakBatch.lock();
+              if (self && batch && self->pendingBatch_ == batch) {
+                self->flushBatch(rt);
+              }
+              return Value::undefined();
+            }),
+        Value(batching_.windowMs));
+  }
+
+  auto promiseCtor = runtime.global().getPropertyAsFunction(runtime, "Promise");
+  auto promise = promiseCtor.callAsConstructor(
+      runtime, Function::createFromHostFunction(
+                   runtime, PropNameID::forAscii(runtime, "executor"), 2,
+                   [&request](Runtime &rt, const Value &thisVal,
+                              const Value *args, size_t count) -> Value {
+                     request.resolve = std::make_shared<Value>(rt, args[0]);
+                     request.reject = std::make_shared<Value>(rt, args[1]);
+                     return Value::undefined();
+                   }));
+
+  auto batch = pendingBatch_;
+  batch->sizes.push_back(size);
+  batch->totalSize += size;
+  batch->requests.push_back(std::move(request));
+  if (batch->totalSize >= static_cast<int64_t>(batching_.maxBatchSize)) {
+    flushBatch(runtime);
+  }
+  return promise;
+}
+
+void InferenceSessionHostObject::flushBatch(Runtime &runtime) {
+  auto batch = std::move(pendingBatch_);
+  pendingBatch_.reset();
+  if (!batch || batch->requests.empty()) {
+    return;
+  }
+  auto worker =
+      std::make_shared<BatchRunAsyncWorker>(runtime, batch, shared_from_this());
+  trackWorker(worker);
+  // The callers hold the requests' promises, not this one: the pool task
+  // keeps the worker alive until it settles, and the worker settles every
+  // request itself. Its own rejection, on abort, is already reported to
+  // them, so it is marked handled.
+  auto promise = worker->toPromise(runtime).asObject(runtime);
+  promise.getPropertyAsFunction(runtime, "catch")
+      .callWithThis(runtime, promise,
+                    Function::createFromHostFunction(
+                        runtime, PropNameID::forAscii(runtime, "ignore"), 1,
+                        [](Runtime &rt, const Value &thisVal,
+                           const Value *args, size_t count) -> Value {
+                          return Value::undefined();
+                        }));
+}
+
 DEFINE_METHOD(InferenceSessionHostObject::run) {
-  auto worker = std::make_shared<RunAsyncWorker>(runtime, arguments, count, env_, session_);
+  if (canBatch(runtime, arguments, count)) {
+    return enqueueBatchedRun(runtime, arguments, count);
+  }
+  auto worker = std::make_shared<RunAsyncWorker>(runtime, arguments, count,
+                                                 shared_from_this());
+  trackWorker(worker);
+  return worker->toPromise(runtime);
+}
+
+DEFINE_METHOD(InferenceSessionHostObject::setBatching) {
+  if (count < 1 || !arguments[0].isObject()) {
+    flushBatch(runtime);
+    batching_ = BatchingOptions();
+    return Value::undefined();
+  }
+  auto options = arguments[0].asObject(runtime);
+  auto number = [&](const char *name, double fallback) {
+    auto prop = options.getProperty(runtime, name);
+    return prop.isNumber() ? prop.asNumber() : fallback;
+  };
+  auto maxBatchSize = number("maxBatchSize", 8);
+  auto windowMs = number("windowMs", 0);
+  auto axis = number("axis", 0);
+  if (maxBatchSize < 1 || windowMs < 0 || axis < 0) {
+    throw JSError(runtime, "Invalid batching options");
+  }
+  flushBatch(runtime);
+  batching_.maxBatchSize = static_cast<size_t>(maxBatchSize);
+  batching_.windowMs = windowMs;
+  batching_.axis = static_cast<size_t>(axis);
+  return Value::undefined();
+}
+
+// Decodes token by token without leaving native code. The KV cache lives in
+// two buffers per past_key_values input, each sized for maxLength tokens;
+// every step reads past from one and has ORT write present into the other.
+class InferenceSessionHostObject::GenerateAsyncWorker : public AsyncWorker {
+public:
+  GenerateAsyncWorker(Runtime &runtime, const Value *arguments, size_t count,
+                      std::shared_ptr<InferenceSessionHostObject> session)
+      : AsyncWorker(runtime, session->env_, session->queue_),
+        session_(session->session_), metadata_(session->metadata_),
+        maxNewTokens_(128), maxLength_(0), stopped_(false) {
+    if (count < 1 || !arguments[0].isObject() ||
+        !arguments[0].asObject(runtime).isArray(runtime)) {
+      throw JSError(runtime, "generate requires an array of prompt token ids");
+    }
+    if (!session->session_)
+      throw JSError(runtime, "Session is not loaded");
+
+    forEach(runtime, arguments[0].asObject(runtime).asArray(runtime),
+            [&](const Value &value, size_t index) {
+              if (!value.isNumber()) {
+                throw JSError(runtime, "Prompt token ids must be numbers");
+              }
+              tokens_.push_back(static_cast<int64_t>(value.asNumber()));
+            });
+    if (tokens_.empty()) {
+      throw JSError(runtime, "Prompt must not be empty");
+    }
+    if (count > 1 && arguments[1].isObject()) {
+      parseOptions(runtime, arguments[1].asObject(runtime));
+    } else {
+      parseScheduling(runtime, nullptr);
+    }
+    if (maxLength_ == 0) {
+      maxLength_ = tokens_.size() + maxNewTokens_;
+    }
+    if (tokens_.size() > maxLength_) {
+      throw JSError(runtime, "Prompt is longer than maxLength");
+    }
+    if (count > 2 && arguments[2].isObject() &&
+        arguments[2].asObject(runtime).isFunction(runtime)) {
+      onToken_ = std::make_shared<Function>(
+          arguments[2].asObject(runtime).asFunction(runtime));
+    }
+    resolveLayout(runtime);
+  }
+
+protected:
+  void execute() {
+    auto session = session_.lock();
+    if (!session) {
+      throw std::runtime_error("Session is released");
+    }
+    auto memoryInfo =
+        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    for (auto &kv : kvCaches_) {
+      size_t capacity = kv.heads * maxLength_ * kv.headDim * kv.elementSize;
+      kv.buffers[0].reset(new uint8_t[capacity]);
+      kv.buffers[1].reset(new uint8_t[capacity]);
+    }
+    std::vector<int64_t> attentionMask(maxLength_, 1);
+    std::vector<int64_t> positionIds(maxLength_);
+    std::iota(positionIds.begin(), positionIds.end(), 0);
+    tokens_.reserve(maxLength_ + 1);
+
+    Sampler sampler(samplerOptions_);
+    std::vector<float> logitsRow;
+    std::vector<Ort::Value> inputValues;
+    std::vector<Ort::Value> outputValues;
+    size_t pastLength = 0;
+    size_t current = 0;
+    while (generated_.size() < maxNewTokens_ && tokens_.size() <= maxLength_ &&
+           !stopped_) {
+      size_t stepLength = tokens_.size() - pastLength;
+      size_t totalLength = tokens_.size();
+      int64_t stepShape[] = {1, static_cast<int64_t>(stepLength)};
+      int64_t totalShape[] = {1, static_cast<int64_t>(totalLength)};
+      int64_t scalarShape[] = {1};
+      bool useCacheBranch = pastLength > 0;
+
+      inputValues.clear();
+      for (const auto &input : inputs_) {
+        switch (input.kind) {
+        case InputKind::InputIds:
+          inputValues.push_back(Ort::Value::CreateTensor<int64_t>(
+              memoryInfo, tokens_.data() + pastLength, stepLength, stepShape,
+              2));
+          break;
+        case InputKind::AttentionMask:
+          inputValues.push_back(Ort::Value::CreateTensor<int64_t>(
+              memoryInfo, attentionMask.data(), totalLength, totalShape, 2));
+          break;
+        case InputKind::PositionIds:
+          inputValues.push_back(Ort::Value::CreateTensor<int64_t>(
+              memoryInfo, positionIds.data() + pastLength, stepLength,
+              stepShape, 2));
+          break;
+        case InputKind::UseCacheBranch:
+          inputValues.push_back(Ort::Value::CreateTensor<bool>(
+              memoryInfo, &useCacheBranch, 1, scalarShape, 1));
+          break;
+        case InputKind::PastKeyValue:
+          inputValues.push_back(kvCaches_[input.kvIndex].view(
+              memoryInfo, current, pastLength));
+          break;
+        }
+      }
+      outputValues.clear();
+      outputValues.emplace_back(nullptr);
+      for (auto &kv : kvCaches_) {
+        outputValues.push_back(kv.view(memoryInfo, 1 - current, totalLength));
+      }
+
+      session->Run(runOptions_, inputNames_.data(), inputValues.data(),
+                   inputValues.size(), outputNames_.data(),
+                   outputValues.data(), outputValues.size());
+
+      auto token = sampleLogits(outputValues[0], sampler, logitsRow);
+      pastLength = totalLength;
+      current = 1 - current;
+      tokens_.push_back(token);
+      generated_.push_back(token);
+      if (onToken_) {
+        runOnJsThread([this, token](Runtime &rt) { emitToken(rt, token); });
+      }
+      if (std::find(eosTokenIds_.begin(), eosTokenIds_.end(), token) !=
+          eosTokenIds_.end()) {
+        break;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    if (!callbackError_.empty()) {
+      throw std::runtime_error(callbackError_);
+    }
+    if (aborted()) {
+      throw std::runtime_error("Aborted");
+    }
+  }
+
+  Value onResolve(Runtime &rt) {
+    auto result = Array(rt, generated_.size());
+    for (size_t i = 0; i < generated_.size(); ++i) {
+      result.setValueAtIndex(rt, i, Value(static_cast<double>(generated_[i])));
+    }
+    defineHiddenProperty(rt, result, "queueWaitMs", queueWaitMs());
+    return Value(rt, result);
+  }
+
+  // Ends generation at the next step, or inside the current one.
+  void onAbort() {
+    stopped_ = true;
+    runOptions_.SetTerminate();
+  }
+
+private:
+  enum class InputKind {
+    InputIds,
+    AttentionMask,
+    PositionIds,
+    UseCacheBranch,
+    PastKeyValue,
+  };
+
+  struct Input {
+    InputKind kind;
+    size_t kvIndex;
+  };
+
+  // One past_key_values input and its present output, laid out as
+  // [1, heads, length, headDim].
+  struct KvCache {
+    ONNXTensorElementDataType type;
+    size_t heads;
+    size_t headDim;
+    size_t elementSize;
+    std::unique_ptr<uint8_t[]> buffers[2];
+
+    Ort::Value view(const Ort::MemoryInfo &memoryInfo, size_t buffer,
+                    size_t length) {
+      int64_t shape[] = {1, static_cast<int64_t>(heads),
+                         static_cast<int64_t>(length),
+                         static_cast<int64_t>(headDim)};
+      return Ort::Value::CreateTensor(memoryInfo, buffers[buffer].get(),
+                                      heads * length * headDim * elementSize,
+                                      shape, 4, type);
+    }
+  };
+
+  void parseOptions(Runtime &runtime, const Object &options) {
+    auto number = [&](const char *name, double fallback) {
+      auto prop = options.getProperty(runtime, name);
+      return prop.isNumber() ? prop.asNumber() : fallback;
+    };
+    maxNewTokens_ = static_cast<size_t>(number("maxNewTokens", 128));
+    maxLength_ = static_cast<size_t>(number("maxLength", 0));
+    samplerOptions_.temperature =
+        static_cast<float>(number("temperature", 1.0));
+    samplerOptions_.topK = static_cast<size_t>(number("topK", 0));
+    samplerOptions_.topP = static_cast<float>(number("topP", 1.0));
+    samplerOptions_.repetitionPenalty =
+        static_cast<float>(number("repetitionPenalty", 1.0));
+    auto doSample = options.getProperty(runtime, "doSample");
+    samplerOptions_.doSample = doSample.isBool() && doSample.getBool();
+    auto seed = options.getProperty(runtime, "seed");
+    samplerOptions_.seed = seed.isNumber()
+                               ? static_cast<uint32_t>(seed.asNumber())
+                               : std::random_device()();
+
+    auto eos = options.getProperty(runtime, "eosTokenId");
+    if (eos.isNumber()) {
+      eosTokenIds_.push_back(static_cast<int64_t>(eos.asNumber()));
+    } else if (eos.isObject() && eos.asObject(runtime).isArray(runtime)) {
+      forEach(runtime, eos.asObject(runtime).asArray(runtime),
+              [&](const Value &value, size_t index) {
+                if (value.isNumber()) {
+                  eosTokenIds_.push_back(
+                      static_cast<int64_t>(value.asNumber()));
+                }
+              });
+    }
+
+    auto runOptions = options.getProperty(runtime, "runOptions");
+    if (!runOptions.isUndefined()) {
+      parseRunOptions(runtime, runOptions, runOptions_);
+    }
+    parseScheduling(runtime, &runOptions);
+  }
+
+  // Maps the model inputs to what each step feeds, following the naming of
+  // Hugging Face Optimum decoder exports.
+  void resolveLayout(Runtime &runtime) {
+    static const std::string pastPrefix = "past_key_values.";
+    static const std::string presentPrefix = "present.";
+    std::unordered_map<std::string, size_t> outputIndices;
+    for (size_t i = 0; i < metadata_->outputs.size(); ++i) {
+      outputIndices.emplace(metadata_->outputs[i].name, i);
+    }
+    auto logits = outputIndices.find("logits");
+    if (logits == outputIndices.end()) {
+      throw JSError(runtime, "generate requires a logits output");
+    }
+    outputNames_.push_back(metadata_->outputs[logits->second].name.c_str());
+
+    bool hasInputIds = false;
+    for (const auto &input : metadata_->inputs) {
+      const auto &name = input.name;
+      inputNames_.push_back(name.c_str());
+      if (name == "input_ids") {
+        inputs_.push_back({InputKind::InputIds, 0});
+        hasInputIds = true;
+      } else if (name == "attention_mask") {
+        inputs_.push_back({InputKind::AttentionMask, 0});
+      } else if (name == "position_ids") {
+        inputs_.push_back({InputKind::PositionIds, 0});
+      } else if (name == "use_cache_branch") {
+        inputs_.push_back({InputKind::UseCacheBranch, 0});
+      } else if (name.compare(0, pastPrefix.size(), pastPrefix) == 0) {
+        auto present =
+            outputIndices.find(presentPrefix + name.substr(pastPrefix.size()));
+        if (present == outputIndices.end()) {
+          throw JSError(runtime, "No present output for " + name);
+        }
+        if (input.shape.size() != 4 || input.shape[1] < 0 ||
+            input.shape[3] < 0) {
+          throw JSError(runtime, "Unsupported KV cache shape for " + name);
+        }
+        if (input.type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT &&
+            input.type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) {
+          throw JSError(runtime, "Unsupported KV cache type for " + name);
+        }
+        KvCache kv;
+        kv.type = input.type;
+        kv.heads = static_cast<size_t>(input.shape[1]);
+        kv.headDim = static_cast<size_t>(input.shape[3]);
+        kv.elementSize =
+            input.type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT ? 4 : 2;
+        inputs_.push_back({InputKind::PastKeyValue, kvCaches_.size()});
+        kvCaches_.push_back(std::move(kv));
+        outputNames_.push_back(
+            metadata_->outputs[present->second].name.c_str());
+      } else {
+        throw JSError(runtime, "Unsupported input for generate: " + name);
+      }
+    }
+    if (!hasInputIds) {
+      throw JSError(runtime, "generate requires an input_ids input");
+    }
+  }
+
+  static float halfToFloat(uint16_t h) {
+    uint32_t sign = (h & 0x8000u) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0x1f) {
+      bits = sign | 0x7f800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+      // Subnormal: normalize into a float exponent.
+      exponent = 113;
+      while ((mantissa & 0x400) == 0) {
+        mantissa <<= 1;
+        --exponent;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    } else {
+      bits = sign;
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+  }
+
+  // Samples from the last position of logits shaped [1, length, vocab].
+  int64_t sampleLogits(Ort::Value &logits, Sampler &sampler,
+                       std::vector<float> &row) {
+    auto info = logits.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    size_t vocabSize = static_cast<size_t>(shape.back());
+    size_t offset = info.GetElementCount() - vocabSize;
+    float *values;
+    if (info.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) {
+      auto half = logits.GetTensorMutableData<uint16_t>() + offset;
+      row.resize(vocabSize);
+      for (size_t i = 0; i < vocabSize; ++i) {
+        row[i] = halfToFloat(half[i]);
+      }
+      values = row.data();
+    } else {
+      values = logits.GetTensorMutableData<float>() + offset;
+    }
+    return sampler.sample(values, vocabSize, tokens_);
+  }
+
+  // Returning false from the callback stops generation after the current
+  // step; a thrown error stops it and rejects the promise.
+  void emitToken(Runtime &rt, int64_t token) {
+    if (stopped_) {
+      return;
+    }
+    try {
+      auto result = onToken_->call(rt, Value(static_cast<double>(token)));
+      if (result.isBool() && !result.getBool()) {
+        stopped_ = true;
+      }
+    } catch (const std::exception &e) {
+      stopped_ = true;
+      std::lock_guard<std::mutex> lock(errorMutex_);
+      callbackError_ = e.what();
+    }
+  }
+
+  std::weak_ptr<Ort::Session> session_;
+  std::shared_ptr<const ModelMetadata> metadata_;
+  std::vector<const char *> inputNames_;
+  std::vector<const char *> outputNames_;
+  std::vector<Input> inputs_;
+  std::vector<KvCache> kvCaches_;
+  Ort::RunOptions runOptions_;
+  Sampler::Options samplerOptions_;
+  size_t maxNewTokens_;
+  size_t maxLength_;
+  std::vector<int64_t> eosTokenIds_;
+  std::shared_ptr<Function> onToken_;
+  // Prompt followed by the generated tokens.
+  std::vector<int64_t> tokens_;
+  std::vector<int64_t> generated_;
+  std::atomic<bool> stopped_;
+  std::mutex errorMutex_;
+  std::string callbackError_;
+};
+
+DEFINE_METHOD(InferenceSessionHostObject::generate) {
+  auto worker = std::make_shared<GenerateAsyncWorker>(
+      runtime, arguments, count, shared_from_this());
+  trackWorker(worker);
   return worker->toPromise(runtime);
 }
 
+void InferenceSessionHostObject::trackWorker(
+    const std::shared_ptr<AsyncWorker> &worker) {
+  workers_.erase(std::remove_if(workers_.begin(), workers_.end(),
+                                [](const std::weak_ptr<AsyncWorker> &weak) {
+                                  auto tracked = weak.lock();
+                                  return !tracked || tracked->settled();
+                                }),
+                 workers_.end());
+  workers_.push_back(worker);
+}
+
+// Queued calls, batched runs included, are rejected unrun and running ones
+// are terminated, so dispose() does not wait behind a long generation. A
+// load in progress runs to completion, then rejects and drops its session.
 DEFINE_METHOD(InferenceSessionHostObject::dispose) {
-  session_.reset();
+  // A batch still collecting requests is aborted with the rest.
+  flushBatch(runtime);
+  for (const auto &weak : workers_) {
+    if (auto worker = weak.lock()) {
+      worker->abort();
+    }
+  }
+  workers_.clear();
+  setSession(nullptr, nullptr);
   return Value::undefined();
 }
 
@@ -224,136 +1547,298 @@ DEFINE_METHOD(InferenceSessionHostObject::endProfiling) {
   try {
     Ort::AllocatorWithDefaultOptions allocator;
     auto filename = session_->EndProfilingAllocated(allocator);
+    profilingEnded_ = true;
     return String::createFromUtf8(runtime, std::string(filename.get()));
   } catch (const std::exception &e) {
     throw JSError(runtime, std::string(e.what()));
   }
 }
 
-DEFINE_GETTER(InferenceSessionHostObject::inputMetadata) {
+DEFINE_METHOD(InferenceSessionHostObject::startProfiling) {
   if (!session_) {
-    return Array(runtime, 0);
+    throw JSError(runtime, "Session is not loaded");
   }
-  try {
+  if (profilingEnded_) {
+    throw JSError(runtime, "Profiling has already ended for this session");
+  }
+  auto startNs = session_->GetProfilingStartTimeNs();
+  if (startNs == 0) {
+    throw JSError(runtime,
+                  "Profiling is not enabled; load the model with "
+                  "enableProfiling");
+  }
+  // ORT stamps events relative to its high_resolution_clock start time.
+  auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::high_resolution_clock::now().time_since_epoch())
+                   .count();
+  profilingWindowUs_ = static_cast<double>(nowNs - startNs) / 1000;
+  return Value::undefined();
+}
+
+// Ends the session's profile on its queue, after any runs already queued,
+// and summarizes the events of the current profiling window.
+class InferenceSessionHostObject::StopProfilingAsyncWorker
+    : public AsyncWorker {
+public:
+  StopProfilingAsyncWorker(Runtime &runtime, const Value *arguments,
+                           size_t count,
+                           std::shared_ptr<InferenceSessionHostObject> session)
+      : AsyncWorker(runtime, session->env_, session->queue_),
+        session_(session->session_), windowUs_(session->profilingWindowUs_) {
+    if (count > 0 && arguments[0].isObject()) {
+      auto keepFile =
+          arguments[0].asObject(runtime).getProperty(runtime, "keepFile");
+      keepFile_ = keepFile.isBool() && keepFile.asBool();
+    }
+  }
+
+protected:
+  void execute() {
     Ort::AllocatorWithDefaultOptions allocator;
-    size_t numInputs = session_->GetInputCount();
-    auto array = Array(runtime, numInputs);
+    startTimeNs_ = session_->GetProfilingStartTimeNs();
+    file_ = session_->EndProfilingAllocated(allocator).get();
+    summary_ = ProfileSummary::fromFile(file_, windowUs_);
+    if (!keepFile_) {
+      std::remove(file_.c_str());
+    }
+  }
 
-    for (size_t i = 0; i < numInputs; i++) {
-      auto item = Object(runtime);
-      auto inputName = session_->GetInputNameAllocated(i, allocator);
-      item.setProperty(
-          runtime, "name",
-          String::createFromUtf8(runtime, std::string(inputName.get())));
+  Value onResolve(Runtime &rt) {
+    auto result = Object(rt);
+    result.setProperty(rt, "runs", static_cast<double>(summary_.runs));
+    result.setProperty(rt, "runTotalMs", summary_.runTotalUs / 1000);
+    result.setProperty(rt, "startTimeUs",
+                       static_cast<double>(startTimeNs_) / 1000);
 
-      try {
-        auto typeInfo = session_->GetInputTypeInfo(i);
-        auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
-
-        // Get data type
-        auto dataType = tensorInfo.GetElementType();
-        item.setProperty(runtime, "type", static_cast<double>(dataType));
-
-        // Get shape
-        auto shape = tensorInfo.GetShape();
-        auto shapeArray = Array(runtime, shape.size());
-        for (size_t j = 0; j < shape.size(); j++) {
-          shapeArray.setValueAtIndex(runtime, j,
-                                     Value(static_cast<double>(shape[j])));
-        }
-        item.setProperty(runtime, "shape", shapeArray);
-
-        item.setProperty(runtime, "isTensor", Value(true));
-
-        // symbolicDimensions
-        auto symbolicDimensions = tensorInfo.GetSymbolicDimensions();
-        auto symbolicDimensionsArray =
-            Array(runtime, symbolicDimensions.size());
-        for (size_t j = 0; j < symbolicDimensions.size(); j++) {
-          symbolicDimensionsArray.setValueAtIndex(
-              runtime, j,
-              String::createFromUtf8(runtime, symbolicDimensions[j]));
-        }
-        item.setProperty(runtime, "symbolicDimensions",
-                         symbolicDimensionsArray);
-      } catch (const std::exception &) {
-        // Fallback for unknown types
-        item.setProperty(runtime, "type",
-                         String::createFromUtf8(runtime, "unknown"));
-        item.setProperty(runtime, "shape", Array(runtime, 0));
-        item.setProperty(runtime, "isTensor", Value(false));
+    auto nodes = Array(rt, summary_.nodes.size());
+    for (size_t i = 0; i < summary_.nodes.size(); ++i) {
+      const auto &node = summary_.nodes[i];
+      auto entry = Object(rt);
+      entry.setProperty(rt, "name", String::createFromUtf8(rt, node.name));
+      entry.setProperty(rt, "opType", String::createFromUtf8(rt, node.opType));
+      entry.setProperty(rt, "provider",
+                        String::createFromUtf8(rt, node.provider));
+      entry.setProperty(rt, "count", static_cast<double>(node.count));
+      entry.setProperty(rt, "totalMs", node.totalUs / 1000);
+      entry.setProperty(rt, "meanMs", node.totalUs / 1000 / node.count);
+      nodes.setValueAtIndex(rt, i, entry);
+    }
+    result.setProperty(rt, "nodes", nodes);
+
+    auto opTypes = Array(rt, summary_.opTypes.size());
+    for (size_t i = 0; i < summary_.opTypes.size(); ++i) {
+      const auto &opType = summary_.opTypes[i];
+      auto providers = Array(rt, opType.providers.size());
+      for (size_t j = 0; j < opType.providers.size(); ++j) {
+        providers.setValueAtIndex(
+            rt, j, String::createFromUtf8(rt, opType.providers[j]));
       }
+      auto entry = Object(rt);
+      entry.setProperty(rt, "opType",
+                        String::createFromUtf8(rt, opType.opType));
+      entry.setProperty(rt, "providers", providers);
+      entry.setProperty(rt, "count", static_cast<double>(opType.count));
+      entry.setProperty(rt, "totalMs", opType.totalUs / 1000);
+      entry.setProperty(rt, "meanMs", opType.totalUs / 1000 / opType.count);
+      opTypes.setValueAtIndex(rt, i, entry);
+    }
+    result.setProperty(rt, "opTypes", opTypes);
 
-      array.setValueAtIndex(runtime, i, Value(runtime, item));
+    if (keepFile_) {
+      result.setProperty(rt, "file", String::createFromUtf8(rt, file_));
     }
+    return Value(rt, result);
+  }
+
+private:
+  std::shared_ptr<Ort::Session> session_;
+  double windowUs_;
+  bool keepFile_ = false;
+  uint64_t startTimeNs_ = 0;
+  std::string file_;
+  ProfileSummary summary_;
+};
+
+DEFINE_METHOD(InferenceSessionHostObject::stopProfiling) {
+  if (!session_) {
+    throw JSError(runtime, "Session is not loaded");
+  }
+  if (profilingEnded_) {
+    throw JSError(runtime, "Profiling has already ended for this session");
+  }
+  if (session_->GetProfilingStartTimeNs() == 0) {
+    throw JSError(runtime,
+                  "Profiling is not enabled; load the model with "
+                  "enableProfiling");
+  }
+  profilingEnded_ = true;
+  auto worker = std::make_shared<StopProfilingAsyncWorker>(
+      runtime, arguments, count, shared_from_this());
+  return worker->toPromise(runtime);
+}
 
-    return Value(runtime, array);
+DEFINE_METHOD(InferenceSessionHostObject::createBinding) {
+  if (!session_) {
+    throw JSError(runtime, "Session is not loaded");
+  }
+  try {
+    return Object::createFromHostObject(
+        runtime,
+        std::make_shared<IoBindingHostObject>(env_, session_, queue_,
+                                              stats_));
   } catch (const Ort::Exception &e) {
     throw JSError(runtime, std::string(e.what()));
   }
 }
 
-DEFINE_GETTER(InferenceSessionHostObject::outputMetadata) {
-  if (!session_) {
+DEFINE_METHOD(InferenceSessionHostObject::validateFeeds) {
+  if (!metadata_) {
+    throw JSError(runtime, "Session is not loaded");
+  }
+  if (count < 1 || !arguments[0].isObject()) {
+    throw JSError(runtime, "validateFeeds requires a feeds object");
+  }
+  ONNXTensorElementDataType type;
+  std::vector<int64_t> shape;
+  forEach(runtime, arguments[0].asObject(runtime),
+          [&](const std::string &key, const Value &value, size_t index) {
+            auto it = inputIndices_.find(key);
+            if (it == inputIndices_.end()) {
+              throw JSError(runtime, "Unknown input name: " + key);
+            }
+            if (!value.isObject()) {
+              throw JSError(runtime, "Input " + key + " is not a tensor");
+            }
+            auto object = value.asObject(runtime);
+            if (auto nativeValue =
+                    OrtValueHostObject::getValue(runtime, object)) {
+              auto info = nativeValue->GetTensorTypeAndShapeInfo();
+              type = info.GetElementType();
+              shape = info.GetShape();
+            } else {
+              auto tensor = TensorUtils::readTensor(runtime, *env_, object);
+              if (!tensor.isTensor()) {
+                throw JSError(runtime, "Input " + key + " is not a tensor");
+              }
+              TensorUtils::getTensorTypeAndShape(runtime, tensor, type, shape);
+            }
+            validateInput(runtime, it->second, type, shape);
+          });
+  return Value::undefined();
+}
+
+Value InferenceSessionHostObject::getMetadataArray(Runtime &runtime,
+                                                   bool outputs) {
+  if (!metadata_) {
     return Array(runtime, 0);
   }
-  try {
-    Ort::AllocatorWithDefaultOptions allocator;
-    size_t numOutputs = session_->GetOutputCount();
-    auto array = Array(runtime, numOutputs);
+  auto &cache = outputs ? jsOutputMetadata_ : jsInputMetadata_;
+  if (cache) {
+    return Value(runtime, *cache);
+  }
 
-    for (size_t i = 0; i < numOutputs; i++) {
-      auto item = Object(runtime);
-      auto outputName = session_->GetOutputNameAllocated(i, allocator);
-      item.setProperty(
-          runtime, "name",
-          String::createFromUtf8(runtime, std::string(outputName.get())));
+  auto freeze = runtime.global()
+                    .getPropertyAsObject(runtime, "Object")
+                    .getPropertyAsFunction(runtime, "freeze");
+  const auto &values = outputs ? metadata_->outputs : metadata_->inputs;
+  auto array = Array(runtime, values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    const auto &metadata = values[i];
+    auto item = Object(runtime);
+    item.setProperty(runtime, "name",
+                     String::createFromUtf8(runtime, metadata.name));
+    if (metadata.isTensor) {
+      item.setProperty(runtime, "type", static_cast<double>(metadata.type));
 
-      try {
-        auto typeInfo = session_->GetOutputTypeInfo(i);
-        auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
-
-        // Get data type
-        auto dataType = tensorInfo.GetElementType();
-        item.setProperty(runtime, "type", static_cast<double>(dataType));
-
-        // Get shape
-        auto shape = tensorInfo.GetShape();
-        auto shapeArray = Array(runtime, shape.size());
-        for (size_t j = 0; j < shape.size(); j++) {
-          shapeArray.setValueAtIndex(runtime, j,
-                                     Value(static_cast<double>(shape[j])));
-        }
-        item.setProperty(runtime, "shape", shapeArray);
-
-        item.setProperty(runtime, "isTensor", Value(true));
-
-        // symbolicDimensions
-        auto symbolicDimensions = tensorInfo.GetSymbolicDimensions();
-        auto symbolicDimensionsArray =
-            Array(runtime, symbolicDimensions.size());
-        for (size_t j = 0; j < symbolicDimensions.size(); j++) {
-          symbolicDimensionsArray.setValueAtIndex(
-              runtime, j,
-              String::createFromUtf8(runtime, symbolicDimensions[j]));
-        }
-        item.setProperty(runtime, "symbolicDimensions",
-                         symbolicDimensionsArray);
-      } catch (const std::exception &) {
-        // Fallback for unknown types
-        item.setProperty(runtime, "type",
-                         String::createFromUtf8(runtime, "unknown"));
-        item.setProperty(runtime, "shape", Array(runtime, 0));
-        item.setProperty(runtime, "isTensor", Value(false));
+      auto shapeArray = Array(runtime, metadata.shape.size());
+      for (size_t j = 0; j < metadata.shape.size(); j++) {
+        shapeArray.setValueAtIndex(
+            runtime, j, Value(static_cast<double>(metadata.shape[j])));
       }
+      item.setProperty(runtime, "shape", freeze.call(runtime, shapeArray));
+
+      item.setProperty(runtime, "isTensor", Value(true));
 
-      array.setValueAtIndex(runtime, i, Value(runtime, item));
+      auto symbolicDimensionsArray =
+          Array(runtime, metadata.symbolicDimensions.size());
+      for (size_t j = 0; j < metadata.symbolicDimensions.size(); j++) {
+        symbolicDimensionsArray.setValueAtIndex(
+            runtime, j,
+            String::createFromUtf8(runtime, metadata.symbolicDimensions[j]));
+      }
+      item.setProperty(runtime, "symbolicDimensions",
+                       freeze.call(runtime, symbolicDimensionsArray));
+    } else {
+      // Fallback for unknown types
+      item.setProperty(runtime, "type",
+                       String::createFromUtf8(runtime, "unknown"));
+      item.setProperty(runtime, "shape",
+                       freeze.call(runtime, Array(runtime, 0)));
+      item.setProperty(runtime, "isTensor", Value(false));
     }
+    array.setValueAtIndex(runtime, i, freeze.call(runtime, item));
+  }
 
-    return Value(runtime, array);
-  } catch (const Ort::Exception &e) {
-    throw JSError(runtime, std::string(e.what()));
+  cache = std::make_shared<Value>(freeze.call(runtime, array));
+  return Value(runtime, *cache);
+}
+
+DEFINE_GETTER(InferenceSessionHostObject::inputMetadata) {
+  return getMetadataArray(runtime, false);
+}
+
+DEFINE_GETTER(InferenceSessionHostObject::outputMetadata) {
+  return getMetadataArray(runtime, true);
+}
+
+DEFINE_METHOD(InferenceSessionHostObject::resetStats) {
+  stats_->reset();
+  return Value::undefined();
+}
+
+DEFINE_GETTER(InferenceSessionHostObject::stats) {
+  auto histogram = [&runtime](const LatencyHistogram &latency) {
+    auto result = Object(runtime);
+    result.setProperty(runtime, "count", static_cast<double>(latency.count()));
+    result.setProperty(runtime, "p50", latency.percentile(0.5));
+    result.setProperty(runtime, "p95", latency.percentile(0.95));
+    result.setProperty(runtime, "p99", latency.percentile(0.99));
+    return result;
+  };
+  auto counter = [](const std::atomic<uint64_t> &value) {
+    return static_cast<double>(value.load(std::memory_order_relaxed));
+  };
+  auto result = Object(runtime);
+  result.setProperty(runtime, "runs", counter(stats_->runs));
+  result.setProperty(runtime, "runsPerSecond", stats_->runsPerSecond());
+  result.setProperty(runtime, "errors", counter(stats_->errors));
+  result.setProperty(runtime, "cancels", counter(stats_->cancels));
+  result.setProperty(runtime, "bytesIn", counter(stats_->bytesIn));
+  result.setProperty(runtime, "bytesOut", counter(stats_->bytesOut));
+  result.setProperty(runtime, "queueMs", histogram(stats_->queueMs));
+  result.setProperty(runtime, "runMs", histogram(stats_->runMs));
+  result.setProperty(runtime, "marshalMs", histogram(stats_->marshalMs));
+  return Value(runtime, result);
+}
+
+DEFINE_METHOD(InferenceSessionHostObject::getMemoryReport) {
+  if (!session_) {
+    throw JSError(runtime, "Session is not loaded");
+  }
+  auto result = Object(runtime);
+  result.setProperty(runtime, "arena",
+                     createAllocatorStats(runtime,
+                                          getAllocatorStats(*session_)));
+  result.setProperty(runtime, "sharedArena", sharedArena_);
+  return Value(runtime, result);
+}
+
+DEFINE_GETTER(InferenceSessionHostObject::warmupMs) {
+  auto result = Array(runtime, warmupMs_.size());
+  for (size_t i = 0; i < warmupMs_.size(); ++i) {
+    result.setValueAtIndex(runtime, i, warmupMs_[i]);
   }
+  return Value(runtime, result);
 }
 
 } // namespace onnxruntimereactnativejsi
@@ -2,25 +2,26 @@
 
 #include "Env.h"
 #include "JsiHelper.hpp"
+#include "SessionStats.h"
 #include <jsi/jsi.h>
 #include <memory>
 #include <onnxruntime_cxx_api.h>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace facebook::jsi;
 
 namespace onnxruntimereactnativejsi {
 
+class AsyncWorker;
+
 class InferenceSessionHostObject
-    : public HostObject,
+    : public JsiHostObject,
       public std::enable_shared_from_this<InferenceSessionHostObject> {
 public:
   InferenceSessionHostObject(std::shared_ptr<Env> env);
-
-  std::vector<PropNameID> getPropertyNames(Runtime &rt) override;
-  Value get(Runtime &runtime, const PropNameID &name) override;
-  void set(Runtime &runtime, const PropNameID &name,
-           const Value &value) override;
+  ~InferenceSessionHostObject();
 
   static inline facebook::jsi::Value
   constructor(std::shared_ptr<Env> env, facebook::jsi::Runtime &runtime,
@@ -33,22 +34,112 @@ public:
 protected:
   class LoadModelAsyncWorker;
   class RunAsyncWorker;
+  class GenerateAsyncWorker;
+  class BatchRunAsyncWorker;
+  class StopProfilingAsyncWorker;
+  struct RunBatch;
+
+  struct ValueMetadata {
+    std::string name;
+    bool isTensor;
+    ONNXTensorElementDataType type;
+    std::vector<int64_t> shape;
+    std::vector<std::string> symbolicDimensions;
+  };
+
+  // Input/output metadata, resolved once per loaded model.
+  struct ModelMetadata {
+    std::vector<ValueMetadata> inputs;
+    std::vector<ValueMetadata> outputs;
+  };
+
+  // Per-run setup for one feed/fetch signature: name pointers in feed and
+  // fetch order and the matching model input/output indices.
+  struct RunPlan {
+    std::shared_ptr<const ModelMetadata> metadata;
+    std::vector<const char *> inputNames;
+    std::vector<const char *> outputNames;
+    std::vector<size_t> inputIndices;
+    std::vector<size_t> outputIndices;
+  };
+
+  // Opt-in coalescing of concurrent run() calls; off while maxBatchSize < 2.
+  struct BatchingOptions {
+    size_t maxBatchSize = 0;
+    double windowMs = 0;
+    size_t axis = 0;
+  };
 
 private:
+  static constexpr size_t kMaxRunPlans = 32;
+
+  void setSession(std::shared_ptr<Ort::Session> session,
+                  std::shared_ptr<const ModelMetadata> metadata);
+  std::shared_ptr<const RunPlan>
+  getRunPlan(Runtime &runtime, const std::string &signature);
+  void validateInput(Runtime &runtime, size_t index,
+                     ONNXTensorElementDataType type,
+                     const std::vector<int64_t> &shape);
+  Value getMetadataArray(Runtime &runtime, bool outputs);
+  bool canBatch(Runtime &runtime, const Value *arguments, size_t count);
+  bool outputsFollowBatch(const RunPlan &plan) const;
+  // Queues a run() call for the pending batch, or runs it on its own when
+  // its outputs cannot be split back.
+  Value enqueueBatchedRun(Runtime &runtime, const Value *arguments,
+                          size_t count);
+  void flushBatch(Runtime &runtime);
+  // Remembers a load, run, batch or generate call so dispose() can abort
+  // it.
+  void trackWorker(const std::shared_ptr<AsyncWorker> &worker);
+
   std::shared_ptr<Env> env_;
   std::shared_ptr<Ort::Session> session_;
+  std::shared_ptr<WorkerPool::SerialQueue> queue_;
+  Ort::MemoryInfo memoryInfo_;
+  std::shared_ptr<const ModelMetadata> metadata_;
+  // Frozen JS views of metadata_, built on first access.
+  std::shared_ptr<Value> jsInputMetadata_;
+  std::shared_ptr<Value> jsOutputMetadata_;
+  std::unordered_map<std::string, size_t> inputIndices_;
+  std::unordered_map<std::string, size_t> outputIndices_;
+  // Keyed by the feed names then the fetch names, NUL separated.
+  std::unordered_map<std::string, std::shared_ptr<const RunPlan>> runPlans_;
+  // Reused for each run's signature so a cached plan costs no allocation.
+  std::string runSignature_;
+  BatchingOptions batching_;
+  // Requests collected within the current batching window.
+  std::shared_ptr<RunBatch> pendingBatch_;
+  // Calls that may still be queued or running, pruned as they settle.
+  std::vector<std::weak_ptr<AsyncWorker>> workers_;
+  // Shared with workers and bindings, which record into it from any thread.
+  std::shared_ptr<SessionStats> stats_;
+  // Latency of each warm-up run of the loaded model.
+  std::vector<double> warmupMs_;
+  // Whether session_ allocates from the Env's shared CPU arena.
+  bool sharedArena_ = false;
+  // Start of the startProfiling() window in the profile's time base, in
+  // microseconds. ORT writes one profile per session, so once it has been
+  // ended profiling cannot be restarted.
+  double profilingWindowUs_ = 0;
+  bool profilingEnded_ = false;
 
   DEFINE_METHOD(loadModel);
   DEFINE_METHOD(run);
   DEFINE_METHOD(dispose);
   DEFINE_METHOD(endProfiling);
+  DEFINE_METHOD(startProfiling);
+  DEFINE_METHOD(stopProfiling);
+  DEFINE_METHOD(createBinding);
+  DEFINE_METHOD(validateFeeds);
+  DEFINE_METHOD(generate);
+  DEFINE_METHOD(setBatching);
+  DEFINE_METHOD(resetStats);
+  DEFINE_METHOD(getMemoryReport);
 
   DEFINE_GETTER(inputMetadata);
   DEFINE_GETTER(outputMetadata);
-
-  JsiMethodMap methods_;
-  JsiGetterMap getters_;
-  JsiSetterMap setters_;
+  DEFINE_GETTER(warmupMs);
+  DEFINE_GETTER(stats);
 };
 
 } // namespace onnxruntimereactnativejsi
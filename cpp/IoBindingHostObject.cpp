@@ -0,0 +1,193 @@
+#include "IoBindingHostObject.h"
+#include "AsyncWorker.h"
+#include "JsiUtils.h"
+#include "SessionUtils.h"
+#include "TensorUtils.h"
+
+using namespace facebook::jsi;
+
+namespace onnxruntimereactnativejsi {
+
+IoBindingHostObject::IoBindingHostObject(
+    std::shared_ptr<Env> env, std::shared_ptr<Ort::Session> session,
+    std::shared_ptr<WorkerPool::SerialQueue> queue,
+    std::shared_ptr<SessionStats> stats)
+    : JsiHostObject({
+          METHOD_INFO(IoBindingHostObject, bindInput, 2),
+          METHOD_INFO(IoBindingHostObject, bindOutput, 2),
+          METHOD_INFO(IoBindingHostObject, clearBoundInputs, 0),
+          METHOD_INFO(IoBindingHostObject, clearBoundOutputs, 0),
+          METHOD_INFO(IoBindingHostObject, run, 1),
+          METHOD_INFO(IoBindingHostObject, dispose, 0),
+      }),
+      env_(env), session_(session), queue_(queue), stats_(stats),
+      binding_(std::make_unique<Ort::IoBinding>(*session)),
+      memoryInfo_(
+          Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)),
+      running_(false) {}
+
+// The binding is only touched from the JS thread while no run is queued, so
+// it needs no locking against the worker.
+void IoBindingHostObject::assertIdle(Runtime &runtime) {
+  if (!binding_) {
+    throw JSError(runtime, "IoBinding is disposed");
+  }
+  if (running_) {
+    throw JSError(runtime,
+                  "IoBinding cannot be changed while a run is pending");
+  }
+}
+
+DEFINE_METHOD(IoBindingHostObject::bindInput) {
+  assertIdle(runtime);
+  if (count < 2 || !arguments[0].isString() || !arguments[1].isObject()) {
+    throw JSError(runtime, "bindInput requires a name and a tensor");
+  }
+  auto name = arguments[0].asString(runtime).utf8(runtime);
+  try {
+    auto value = TensorUtils::createOrtValueFromJSTensor(
+        runtime, *env_, arguments[1].asObject(runtime), memoryInfo_);
+    binding_->BindInput(name.c_str(), value);
+  } catch (const Ort::Exception &e) {
+    throw JSError(runtime, std::string(e.what()));
+  }
+  inputs_[name] = std::make_shared<Value>(runtime, arguments[1]);
+  return Value::undefined();
+}
+
+DEFINE_METHOD(IoBindingHostObject::bindOutput) {
+  assertIdle(runtime);
+  if (count < 1 || !arguments[0].isString()) {
+    throw JSError(runtime, "bindOutput requires a name");
+  }
+  auto name = arguments[0].asString(runtime).utf8(runtime);
+  try {
+    auto tensor = count > 1 && arguments[1].isObject()
+                      ? TensorUtils::readTensor(runtime, *env_,
+                                                arguments[1].asObject(runtime))
+                      : JSTensorProperties();
+    if (tensor.isTensor()) {
+      auto value = TensorUtils::createOrtValueFromJSTensor(runtime, *env_,
+                                                           tensor, memoryInfo_);
+      binding_->BindOutput(name.c_str(), value);
+      outputs_[name] = std::make_shared<Value>(runtime, arguments[1]);
+    } else {
+      binding_->BindOutput(name.c_str(), memoryInfo_);
+      outputs_[name] = nullptr;
+    }
+  } catch (const Ort::Exception &e) {
+    throw JSError(runtime, std::string(e.what()));
+  }
+  return Value::undefined();
+}
+
+DEFINE_METHOD(IoBindingHostObject::clearBoundInputs) {
+  assertIdle(runtime);
+  binding_->ClearBoundInputs();
+  inputs_.clear();
+  return Value::undefined();
+}
+
+DEFINE_METHOD(IoBindingHostObject::clearBoundOutputs) {
+  assertIdle(runtime);
+  binding_->ClearBoundOutputs();
+  outputs_.clear();
+  return Value::undefined();
+}
+
+class IoBindingHostObject::RunAsyncWorker : public AsyncWorker {
+public:
+  RunAsyncWorker(Runtime &runtime, const Value *arguments, size_t count,
+                 std::shared_ptr<IoBindingHostObject> binding)
+      : AsyncWorker(runtime, binding->env_, binding->queue_),
+        binding_(binding) {
+    if (count > 0 && !arguments[0].isUndefined()) {
+      parseRunOptions(runtime, arguments[0], runOptions_);
+    }
+    parseScheduling(runtime, count > 0 ? &arguments[0] : nullptr);
+    parseTimings(runtime, count > 0 ? &arguments[0] : nullptr);
+  }
+
+protected:
+  void execute() {
+    auto &ioBinding = *binding_->binding_;
+    ioBinding.SynchronizeInputs();
+    auto start = std::chrono::steady_clock::now();
+    binding_->session_->Run(runOptions_, ioBinding);
+    runMs_ = std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+    ioBinding.SynchronizeOutputs();
+    outputNames_ = ioBinding.GetOutputNames();
+    outputValues_ = ioBinding.GetOutputValues();
+  }
+
+  Value onResolve(Runtime &rt) {
+    binding_->running_ = false;
+    auto resultObject = Object(rt);
+    auto tensorConstructor =
+        binding_->env_->getTensorConstructor(rt).asObject(rt);
+    size_t bytesOut = 0;
+    for (size_t i = 0; i < outputNames_.size(); ++i) {
+      auto output = binding_->outputs_.find(outputNames_[i]);
+      if (output != binding_->outputs_.end() && output->second != nullptr) {
+        resultObject.setProperty(rt, outputNames_[i].c_str(),
+                                 Value(rt, *output->second));
+      } else {
+        bytesOut += TensorUtils::getByteLength(outputValues_[i]);
+        auto tensorObj = TensorUtils::createJSTensorFromOrtValue(
+            rt, *binding_->env_, outputValues_[i], tensorConstructor);
+        resultObject.setProperty(rt, outputNames_[i].c_str(),
+                                 Value(rt, tensorObj));
+      }
+    }
+    defineHiddenProperty(rt, resultObject, "queueWaitMs", queueWaitMs());
+    if (timingsEnabled()) {
+      defineHiddenProperty(rt, resultObject, "timings",
+                           createTimings(rt, runMs_));
+    }
+    // Inputs are bound ahead of time, so there is no per-run input cost.
+    auto &stats = *binding_->stats_;
+    stats.queueMs.record(queueWaitMs());
+    stats.runMs.record(runMs_);
+    stats.marshalMs.record(marshalMs());
+    stats.bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+    stats.runs.fetch_add(1, std::memory_order_relaxed);
+    return Value(rt, resultObject);
+  }
+
+  Value onReject(Runtime &rt, const std::string &err) {
+    binding_->running_ = false;
+    (expired() ? binding_->stats_->cancels : binding_->stats_->errors)
+        .fetch_add(1, std::memory_order_relaxed);
+    return AsyncWorker::onReject(rt, err);
+  }
+
+private:
+  std::shared_ptr<IoBindingHostObject> binding_;
+  Ort::RunOptions runOptions_;
+  std::vector<std::string> outputNames_;
+  std::vector<Ort::Value> outputValues_;
+  double runMs_ = 0;
+};
+
+DEFINE_METHOD(IoBindingHostObject::run) {
+  assertIdle(runtime);
+  auto worker = std::make_shared<RunAsyncWorker>(runtime, arguments, count,
+                                                 shared_from_this());
+  // Cleared when the worker settles, which for a full queue happens inside
+  // toPromise(). The pool task keeps the worker alive until then.
+  running_ = true;
+  return worker->toPromise(runtime);
+}
+
+DEFINE_METHOD(IoBindingHostObject::dispose) {
+  assertIdle(runtime);
+  binding_.reset();
+  inputs_.clear();
+  outputs_.clear();
+  session_.reset();
+  return Value::undefined();
+}
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Env.h"
+#include "JsiHelper.hpp"
+#include "SessionStats.h"
+#include <jsi/jsi.h>
+#include <memory>
+#include <onnxruntime_cxx_api.h>
+#include <string>
+#include <unordered_map>
+
+using namespace facebook::jsi;
+
+namespace onnxruntimereactnativejsi {
+
+// Wraps Ort::IoBinding so repeated runs reuse the same bound inputs and
+// outputs instead of marshalling feeds and fetches on every call.
+class IoBindingHostObject
+    : public JsiHostObject,
+      public std::enable_shared_from_this<IoBindingHostObject> {
+public:
+  IoBindingHostObject(std::shared_ptr<Env> env,
+                      std::shared_ptr<Ort::Session> session,
+                      std::shared_ptr<WorkerPool::SerialQueue> queue,
+                      std::shared_ptr<SessionStats> stats);
+
+protected:
+  class RunAsyncWorker;
+
+private:
+  void assertIdle(Runtime &runtime);
+
+  std::shared_ptr<Env> env_;
+  std::shared_ptr<Ort::Session> session_;
+  std::shared_ptr<WorkerPool::SerialQueue> queue_;
+  // The session's stats, which runs through the binding count towards.
+  std::shared_ptr<SessionStats> stats_;
+  std::unique_ptr<Ort::IoBinding> binding_;
+  Ort::MemoryInfo memoryInfo_;
+  // Keeps the JS tensors whose memory is bound alive. Outputs bound to ORT
+  // allocated memory map to nullptr.
+  std::unordered_map<std::string, std::shared_ptr<Value>> inputs_;
+  std::unordered_map<std::string, std::shared_ptr<Value>> outputs_;
+  bool running_;
+
+  DEFINE_METHOD(bindInput);
+  DEFINE_METHOD(bindOutput);
+  DEFINE_METHOD(clearBoundInputs);
+  DEFINE_METHOD(clearBoundOutputs);
+  DEFINE_METHOD(run);
+  DEFINE_METHOD(dispose);
+};
+
+} // namespace onnxruntimereactnativejsi
@@ -5,6 +5,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #define BIND_METHOD(method)                                                    \
   std::bind(&method, std::placeholders::_1, std::placeholders::_2,             \
@@ -62,3 +64,121 @@ struct JsiMethodInfo {
 typedef std::unordered_map<std::string, JsiMethodInfo> JsiMethodMap;
 typedef std::unordered_map<std::string, JsiGetter> JsiGetterMap;
 typedef std::unordered_map<std::string, JsiSetter> JsiSetterMap;
+
+// HostObject that dispatches property access through method, getter and
+// setter maps. The maps are merged per runtime into a list of entries
+// holding their PropNameIDs, so a lookup compares interned names, which
+// allocates nothing, instead of converting them to UTF-8. Each hit moves its
+// entry one step forward, so the members used most are found first. The
+// Function objects created for methods are cached too, so repeated
+// `obj.method(...)` calls do not recreate them.
+class JsiHostObject : public facebook::jsi::HostObject {
+public:
+  std::vector<facebook::jsi::PropNameID>
+  getPropertyNames(facebook::jsi::Runtime &runtime) override {
+    auto &cache = getCache(runtime);
+    std::vector<facebook::jsi::PropNameID> names;
+    names.reserve(cache.size());
+    for (auto &entry : cache) {
+      if (entry.method || entry.getter) {
+        names.emplace_back(runtime, entry.name);
+      }
+    }
+    return names;
+  }
+
+  facebook::jsi::Value get(facebook::jsi::Runtime &runtime,
+                           const facebook::jsi::PropNameID &name) override {
+    auto *entry = findEntry(runtime, name);
+    if (entry == nullptr) {
+      return facebook::jsi::Value::undefined();
+    }
+    if (entry->method) {
+      if (!entry->function) {
+        entry->function = std::make_unique<facebook::jsi::Function>(
+            facebook::jsi::Function::createFromHostFunction(
+                runtime, entry->name, entry->method->count,
+                entry->method->method));
+      }
+      return facebook::jsi::Value(runtime, *entry->function);
+    }
+    if (entry->getter) {
+      return (*entry->getter)(runtime);
+    }
+    return facebook::jsi::Value::undefined();
+  }
+
+  void set(facebook::jsi::Runtime &runtime,
+           const facebook::jsi::PropNameID &name,
+           const facebook::jsi::Value &value) override {
+    auto *entry = findEntry(runtime, name);
+    if (entry != nullptr && entry->setter) {
+      (*entry->setter)(runtime, value);
+    }
+  }
+
+protected:
+  JsiHostObject(JsiMethodMap methods, JsiGetterMap getters = {},
+                JsiSetterMap setters = {})
+      : methods_(std::move(methods)), getters_(std::move(getters)),
+        setters_(std::move(setters)) {}
+
+  JsiMethodMap methods_;
+  JsiGetterMap getters_;
+  JsiSetterMap setters_;
+
+private:
+  struct Entry {
+    facebook::jsi::PropNameID name;
+    const JsiMethodInfo *method;
+    const JsiGetter *getter;
+    const JsiSetter *setter;
+    std::unique_ptr<facebook::jsi::Function> function;
+  };
+
+  std::vector<Entry> &getCache(facebook::jsi::Runtime &runtime) {
+    if (cacheRuntime_ == &runtime) {
+      return cache_;
+    }
+    cache_.clear();
+    cacheRuntime_ = &runtime;
+    // Indices by name, only while merging the maps.
+    std::unordered_map<std::string, size_t> indices;
+    auto entryFor = [&](const std::string &name) -> Entry & {
+      auto it = indices.emplace(name, cache_.size());
+      if (it.second) {
+        cache_.push_back({facebook::jsi::PropNameID::forUtf8(runtime, name),
+                          nullptr, nullptr, nullptr, nullptr});
+      }
+      return cache_[it.first->second];
+    };
+    for (auto &[name, info] : methods_) {
+      entryFor(name).method = &info;
+    }
+    for (auto &[name, getter] : getters_) {
+      entryFor(name).getter = &getter;
+    }
+    for (auto &[name, setter] : setters_) {
+      entryFor(name).setter = &setter;
+    }
+    return cache_;
+  }
+
+  Entry *findEntry(facebook::jsi::Runtime &runtime,
+                   const facebook::jsi::PropNameID &name) {
+    auto &cache = getCache(runtime);
+    for (size_t i = 0; i < cache.size(); ++i) {
+      if (facebook::jsi::PropNameID::compare(runtime, cache[i].name, name)) {
+        if (i > 0) {
+          std::swap(cache[i - 1], cache[i]);
+          --i;
+        }
+        return &cache[i];
+      }
+    }
+    return nullptr;
+  }
+
+  facebook::jsi::Runtime *cacheRuntime_ = nullptr;
+  std::vector<Entry> cache_;
+};
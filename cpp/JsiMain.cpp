@@ -1,13 +1,129 @@
 #include "JsiMain.h"
 #include "InferenceSessionHostObject.h"
 #include "JsiHelper.hpp"
+#include "OrtValueHostObject.h"
 #include "SessionUtils.h"
+#include "TensorUtils.h"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <string>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
 
 using namespace facebook::jsi;
 
 namespace onnxruntimereactnativejsi {
 
+static constexpr size_t kDefaultTraceCapacity = 16384;
+
+static GlobalThreadPoolOptions
+parseGlobalThreadPoolOptions(Runtime &runtime, const Object &options) {
+  GlobalThreadPoolOptions threadPools;
+  auto intraOpNumThreads = options.getProperty(runtime, "intraOpNumThreads");
+  if (intraOpNumThreads.isNumber()) {
+    threadPools.intraOpNumThreads =
+        static_cast<int>(intraOpNumThreads.asNumber());
+  }
+  auto interOpNumThreads = options.getProperty(runtime, "interOpNumThreads");
+  if (interOpNumThreads.isNumber()) {
+    threadPools.interOpNumThreads =
+        static_cast<int>(interOpNumThreads.asNumber());
+  }
+  auto allowSpinning = options.getProperty(runtime, "allowSpinning");
+  if (allowSpinning.isBool()) {
+    threadPools.allowSpinning = allowSpinning.asBool();
+  }
+  auto affinity = options.getProperty(runtime, "intraOpThreadAffinity");
+  if (affinity.isString()) {
+    threadPools.intraOpThreadAffinity =
+        affinity.asString(runtime).utf8(runtime);
+  }
+  return threadPools;
+}
+
+static SharedArenaOptions parseSharedArenaOptions(Runtime &runtime,
+                                                  const Object &options) {
+  SharedArenaOptions arena;
+  auto maxMemory = options.getProperty(runtime, "maxMemory");
+  if (maxMemory.isNumber() && maxMemory.asNumber() >= 0) {
+    arena.maxMemory = static_cast<size_t>(maxMemory.asNumber());
+  }
+  auto extendStrategy = options.getProperty(runtime, "extendStrategy");
+  if (extendStrategy.isString()) {
+    auto strategy = extendStrategy.asString(runtime).utf8(runtime);
+    if (strategy == "nextPowerOfTwo") {
+      arena.extendStrategy = 0;
+    } else if (strategy == "sameAsRequested") {
+      arena.extendStrategy = 1;
+    } else {
+      throw JSError(runtime, "Unknown arena extend strategy: " + strategy);
+    }
+  }
+  auto initialChunkSize = options.getProperty(runtime, "initialChunkSizeBytes");
+  if (initialChunkSize.isNumber()) {
+    arena.initialChunkSizeBytes =
+        static_cast<int>(initialChunkSize.asNumber());
+  }
+  auto maxDeadBytes = options.getProperty(runtime, "maxDeadBytesPerChunk");
+  if (maxDeadBytes.isNumber()) {
+    arena.maxDeadBytesPerChunk = static_cast<int>(maxDeadBytes.asNumber());
+  }
+  return arena;
+}
+
+// Threads in this process, ORT's and everyone else's, or -1 if unknown.
+static int countProcessThreads() {
+#ifdef __APPLE__
+  thread_act_array_t threads;
+  mach_msg_type_number_t count;
+  if (task_threads(mach_task_self(), &threads, &count) != KERN_SUCCESS) {
+    return -1;
+  }
+  for (mach_msg_type_number_t i = 0; i < count; ++i) {
+    mach_port_deallocate(mach_task_self(), threads[i]);
+  }
+  vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(threads),
+                count * sizeof(thread_act_t));
+  return static_cast<int>(count);
+#else
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 8, "Threads:") == 0) {
+      return std::atoi(line.c_str() + 8);
+    }
+  }
+  return -1;
+#endif
+}
+
+// Resident memory of the whole process in bytes, or -1 if unknown.
+static double getResidentBytes() {
+#ifdef __APPLE__
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return -1;
+  }
+  return static_cast<double>(info.resident_size);
+#else
+  std::ifstream statm("/proc/self/statm");
+  long size = 0;
+  long resident = 0;
+  if (!(statm >> size >> resident)) {
+    return -1;
+  }
+  return static_cast<double>(resident) * sysconf(_SC_PAGESIZE);
+#endif
+}
+
 std::shared_ptr<Env>
 install(Runtime &runtime,
         std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
@@ -16,7 +132,7 @@ install(Runtime &runtime,
     auto ortApi = Object(runtime);
 
     auto initOrtOnceMethod = Function::createFromHostFunction(
-        runtime, PropNameID::forAscii(runtime, "initOrtOnce"), 2,
+        runtime, PropNameID::forAscii(runtime, "initOrtOnce"), 3,
         [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
               size_t count) -> Value {
           try {
@@ -46,7 +162,53 @@ install(Runtime &runtime,
             }
             env->setTensorConstructor(std::make_shared<WeakObject>(
                 runtime, arguments[1].asObject(runtime)));
-            env->initOrtEnv(logLevel, "onnxruntime-react-native-jsi");
+
+            std::unique_ptr<GlobalThreadPoolOptions> threadPools;
+            std::unique_ptr<SharedArenaOptions> sharedArena;
+            if (count > 2 && arguments[2].isObject()) {
+              auto options = arguments[2].asObject(runtime);
+              if (options.hasProperty(runtime, "globalThreadPools")) {
+                auto prop = options.getProperty(runtime, "globalThreadPools");
+                if (prop.isObject()) {
+                  threadPools = std::make_unique<GlobalThreadPoolOptions>(
+                      parseGlobalThreadPoolOptions(runtime,
+                                                   prop.asObject(runtime)));
+                }
+              }
+              if (options.hasProperty(runtime, "sharedCpuArena")) {
+                auto prop = options.getProperty(runtime, "sharedCpuArena");
+                if (prop.isObject()) {
+                  sharedArena = std::make_unique<SharedArenaOptions>(
+                      parseSharedArenaOptions(runtime,
+                                              prop.asObject(runtime)));
+                }
+              }
+            }
+            env->initOrtEnv(logLevel, "onnxruntime-react-native-jsi",
+                            threadPools.get(), sharedArena.get());
+
+            if (count > 2 && arguments[2].isObject()) {
+              auto options = arguments[2].asObject(runtime);
+              if (options.hasProperty(runtime, "workerPoolSize")) {
+                auto prop = options.getProperty(runtime, "workerPoolSize");
+                if (prop.isNumber() && prop.asNumber() > 0) {
+                  env->initWorkerPool(static_cast<size_t>(prop.asNumber()));
+                }
+              }
+              if (options.hasProperty(runtime, "maxQueueDepth")) {
+                auto prop = options.getProperty(runtime, "maxQueueDepth");
+                if (prop.isNumber() && prop.asNumber() >= 0) {
+                  env->setMaxQueueDepth(static_cast<size_t>(prop.asNumber()));
+                }
+              }
+              if (options.hasProperty(runtime, "sessionMemoryBudget")) {
+                auto prop = options.getProperty(runtime, "sessionMemoryBudget");
+                if (prop.isNumber() && prop.asNumber() >= 0) {
+                  env->getSessionRegistry().setBudget(
+                      static_cast<size_t>(prop.asNumber()));
+                }
+              }
+            }
             return Value::undefined();
           } catch (const std::exception &e) {
             throw JSError(runtime, "Failed to initialize ONNX Runtime: " +
@@ -82,6 +244,240 @@ install(Runtime &runtime,
     ortApi.setProperty(runtime, "listSupportedBackends",
                        listSupportedBackendsMethod);
 
+    auto getWorkerPoolStatsMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "getWorkerPoolStats"), 0,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          auto stats = env->getWorkerPool().getStats();
+          auto result = Object(runtime);
+          result.setProperty(runtime, "size", static_cast<double>(stats.size));
+          result.setProperty(runtime, "queueDepth",
+                             static_cast<double>(stats.queueDepth));
+          result.setProperty(runtime, "activeWorkers",
+                             static_cast<double>(stats.activeWorkers));
+          result.setProperty(runtime, "submitted",
+                             static_cast<double>(stats.submitted));
+          result.setProperty(runtime, "completed",
+                             static_cast<double>(stats.completed));
+          result.setProperty(runtime, "utilization", stats.utilization);
+          return Value(runtime, result);
+        });
+
+    ortApi.setProperty(runtime, "getWorkerPoolStats",
+                       getWorkerPoolStatsMethod);
+
+    auto getSessionRegistryStatsMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "getSessionRegistryStats"), 0,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          auto stats = env->getSessionRegistry().getStats();
+          auto result = Object(runtime);
+          result.setProperty(runtime, "sessions",
+                             static_cast<double>(stats.sessions));
+          result.setProperty(runtime, "idleSessions",
+                             static_cast<double>(stats.idleSessions));
+          result.setProperty(runtime, "bytes",
+                             static_cast<double>(stats.bytes));
+          result.setProperty(runtime, "budget",
+                             static_cast<double>(stats.budget));
+          return Value(runtime, result);
+        });
+
+    ortApi.setProperty(runtime, "getSessionRegistryStats",
+                       getSessionRegistryStatsMethod);
+
+    auto getThreadStatsMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "getThreadStats"), 0,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          auto result = Object(runtime);
+          auto threadPools = env->getGlobalThreadPools();
+          result.setProperty(runtime, "globalThreadPools",
+                             threadPools != nullptr);
+          if (threadPools) {
+            result.setProperty(runtime, "intraOpNumThreads",
+                               threadPools->intraOpNumThreads);
+            result.setProperty(runtime, "interOpNumThreads",
+                               threadPools->interOpNumThreads);
+          }
+          result.setProperty(
+              runtime, "workerPoolSize",
+              static_cast<double>(env->getWorkerPool().getStats().size));
+          result.setProperty(runtime, "processThreads",
+                             countProcessThreads());
+          return Value(runtime, result);
+        });
+
+    ortApi.setProperty(runtime, "getThreadStats", getThreadStatsMethod);
+
+    auto registerSharedInitializerMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "registerSharedInitializer"), 2,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          if (count < 2 || !arguments[0].isString() ||
+              !arguments[1].isObject()) {
+            throw JSError(runtime,
+                          "registerSharedInitializer requires a name and a "
+                          "tensor");
+          }
+          auto object = arguments[1].asObject(runtime);
+          auto value = OrtValueHostObject::getValue(runtime, object);
+          try {
+            // Tensors from JS are copied so the initializer does not depend
+            // on the lifetime of their ArrayBuffer.
+            if (!value) {
+              auto memoryInfo = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator,
+                                                           OrtMemTypeDefault);
+              auto view = TensorUtils::createOrtValueFromJSTensor(
+                  runtime, *env, object, memoryInfo);
+              Ort::AllocatorWithDefaultOptions allocator;
+              value = std::make_shared<Ort::Value>(
+                  TensorUtils::cloneTensor(view, allocator));
+            } else if (value->GetTensorTypeAndShapeInfo().GetElementType() ==
+                       ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+              throw JSError(runtime, "String tensors cannot be initializers");
+            }
+          } catch (const JSError &) {
+            throw;
+          } catch (const std::exception &e) {
+            throw JSError(runtime, std::string(e.what()));
+          }
+          auto name = arguments[0].asString(runtime).utf8(runtime);
+          env->setSharedInitializer(name, value);
+          return Value::undefined();
+        });
+
+    ortApi.setProperty(runtime, "registerSharedInitializer",
+                       registerSharedInitializerMethod);
+
+    auto unregisterSharedInitializerMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "unregisterSharedInitializer"),
+        1,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          if (count < 1 || !arguments[0].isString()) {
+            throw JSError(runtime,
+                          "unregisterSharedInitializer requires a name");
+          }
+          auto name = arguments[0].asString(runtime).utf8(runtime);
+          env->setSharedInitializer(name, nullptr);
+          return Value::undefined();
+        });
+
+    ortApi.setProperty(runtime, "unregisterSharedInitializer",
+                       unregisterSharedInitializerMethod);
+
+    auto getMemoryReportMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "getMemoryReport"), 0,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          auto sessions = env->getLiveSessions();
+          // Per-session arenas, summed; shared sessions count once. The
+          // shared arena is read through any session allocating from it.
+          std::map<std::string, double> arena;
+          std::map<std::string, double> sharedArena;
+          for (const auto &live : sessions) {
+            auto stats = getAllocatorStats(*live.session);
+            if (live.sharedArena) {
+              sharedArena = std::move(stats);
+              continue;
+            }
+            for (const auto &entry : stats) {
+              arena[entry.first] += entry.second;
+            }
+          }
+          size_t initializerBytes = 0;
+          for (const auto &entry : env->getSharedInitializers()) {
+            initializerBytes += TensorUtils::getByteLength(*entry.second);
+          }
+          auto result = Object(runtime);
+          result.setProperty(runtime, "residentBytes", getResidentBytes());
+          result.setProperty(runtime, "sessions",
+                             static_cast<double>(sessions.size()));
+          result.setProperty(runtime, "arena",
+                             createAllocatorStats(runtime, arena));
+          result.setProperty(runtime, "sharedArena",
+                             createAllocatorStats(runtime, sharedArena));
+          result.setProperty(
+              runtime, "sessionRegistryBytes",
+              static_cast<double>(env->getSessionRegistry().getStats().bytes));
+          result.setProperty(runtime, "sharedInitializerBytes",
+                             static_cast<double>(initializerBytes));
+          return Value(runtime, result);
+        });
+
+    ortApi.setProperty(runtime, "getMemoryReport", getMemoryReportMethod);
+
+    auto startTracingMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "startTracing"), 1,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          size_t capacity = kDefaultTraceCapacity;
+          if (count > 0 && arguments[0].isObject()) {
+            auto prop =
+                arguments[0].asObject(runtime).getProperty(runtime, "capacity");
+            if (prop.isNumber() && prop.asNumber() >= 1) {
+              capacity = static_cast<size_t>(prop.asNumber());
+            }
+          }
+          env->getTrace().start(capacity);
+          return Value::undefined();
+        });
+
+    ortApi.setProperty(runtime, "startTracing", startTracingMethod);
+
+    auto stopTracingMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "stopTracing"), 0,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          env->getTrace().stop();
+          return Value::undefined();
+        });
+
+    ortApi.setProperty(runtime, "stopTracing", stopTracingMethod);
+
+    auto exportTraceMethod = Function::createFromHostFunction(
+        runtime, PropNameID::forAscii(runtime, "exportTrace"), 1,
+        [env](Runtime &runtime, const Value &thisValue, const Value *arguments,
+              size_t count) -> Value {
+          std::string ortProfile;
+          int64_t ortStartNs = 0;
+          bool clear = false;
+          if (count > 0 && arguments[0].isObject()) {
+            auto options = arguments[0].asObject(runtime);
+            auto profile = options.getProperty(runtime, "profile");
+            if (profile.isObject()) {
+              auto profileObject = profile.asObject(runtime);
+              auto file = profileObject.getProperty(runtime, "file");
+              auto startTimeUs =
+                  profileObject.getProperty(runtime, "startTimeUs");
+              if (!file.isString() || !startTimeUs.isNumber()) {
+                throw JSError(runtime,
+                              "profile requires file and startTimeUs");
+              }
+              auto path = file.asString(runtime).utf8(runtime);
+              std::ifstream stream(path);
+              if (!stream) {
+                throw JSError(runtime, "Failed to open profile " + path);
+              }
+              ortProfile.assign(std::istreambuf_iterator<char>(stream),
+                                std::istreambuf_iterator<char>());
+              ortStartNs =
+                  static_cast<int64_t>(startTimeUs.asNumber() * 1000);
+            }
+            auto clearProp = options.getProperty(runtime, "clear");
+            clear = clearProp.isBool() && clearProp.asBool();
+          }
+          auto &trace = env->getTrace();
+          auto json = trace.toJson(ortProfile, ortStartNs);
+          if (clear) {
+            trace.clear();
+          }
+          return String::createFromUtf8(runtime, json);
+        });
+
+    ortApi.setProperty(runtime, "exportTrace", exportTraceMethod);
+
     ortApi.setProperty(
         runtime, "version",
         String::createFromUtf8(runtime, OrtGetApiBase()->GetVersionString()));
@@ -12,6 +12,39 @@ bool isTypedArray(Runtime &runtime, const Object &jsObj) {
   return true;
 }
 
+uint8_t *getTypedArrayData(Runtime &runtime, const Object &typedArray,
+                           size_t &byteLength) {
+  auto buffer = typedArray.getProperty(runtime, "buffer")
+                    .asObject(runtime)
+                    .getArrayBuffer(runtime);
+  size_t bufferSize = buffer.size(runtime);
+  size_t byteOffset = 0;
+  byteLength = bufferSize;
+  auto offsetValue = typedArray.getProperty(runtime, "byteOffset");
+  if (offsetValue.isNumber()) {
+    byteOffset = static_cast<size_t>(offsetValue.asNumber());
+  }
+  auto lengthValue = typedArray.getProperty(runtime, "byteLength");
+  if (lengthValue.isNumber()) {
+    byteLength = static_cast<size_t>(lengthValue.asNumber());
+  }
+  if (byteOffset > bufferSize || byteLength > bufferSize - byteOffset) {
+    throw JSError(runtime, "TypedArray view is out of ArrayBuffer bounds");
+  }
+  return buffer.data(runtime) + byteOffset;
+}
+
+void defineHiddenProperty(Runtime &runtime, const Object &object,
+                          const char *name, const Value &value) {
+  auto descriptor = Object(runtime);
+  descriptor.setProperty(runtime, "value", value);
+  runtime.global()
+      .getPropertyAsObject(runtime, "Object")
+      .getPropertyAsFunction(runtime, "defineProperty")
+      .call(runtime, object, String::createFromAscii(runtime, name),
+            descriptor);
+}
+
 void forEach(Runtime &runtime, const Object &object,
              const std::function<void(const std::string &, const Value &,
                                       size_t)> &callback) {
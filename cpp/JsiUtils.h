@@ -7,6 +7,18 @@
 bool isTypedArray(facebook::jsi::Runtime &runtime,
                   const facebook::jsi::Object &jsObj);
 
+// Returns the bytes a TypedArray views, honoring its byteOffset and
+// byteLength, after checking that the view lies inside its ArrayBuffer.
+uint8_t *getTypedArrayData(facebook::jsi::Runtime &runtime,
+                           const facebook::jsi::Object &typedArray,
+                           size_t &byteLength);
+
+// Defines a read-only, non-enumerable property, e.g. to attach metadata to
+// a result object without it showing up as one of its entries.
+void defineHiddenProperty(facebook::jsi::Runtime &runtime,
+                          const facebook::jsi::Object &object,
+                          const char *name, const facebook::jsi::Value &value);
+
 void forEach(
     facebook::jsi::Runtime &runtime, const facebook::jsi::Object &object,
     const std::function<void(const std::string &, const facebook::jsi::Value &,
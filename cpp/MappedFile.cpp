@@ -0,0 +1,67 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace onnxruntimereactnativejsi {
+
+MappedFile::MappedFile(const std::string &path) : data_(nullptr), size_(0) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path + ": " +
+                             std::strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int error = errno;
+    close(fd);
+    throw std::runtime_error("Failed to stat " + path + ": " +
+                             std::strerror(error));
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0) {
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      int error = errno;
+      close(fd);
+      throw std::runtime_error("Failed to map " + path + ": " +
+                               std::strerror(error));
+    }
+    data_ = static_cast<uint8_t *>(data);
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(data_, size_);
+  }
+}
+
+std::string MappedFile::toPath(const std::string &uri) {
+  if (uri.compare(0, 7, "file://") == 0) {
+    return uri.substr(7);
+  }
+  return uri;
+}
+
+std::string MappedFile::fileIdentity(const std::string &path) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    return "";
+  }
+#if defined(__APPLE__)
+  const auto &mtime = st.st_mtimespec;
+#else
+  const auto &mtime = st.st_mtim;
+#endif
+  return std::to_string(st.st_size) + ":" + std::to_string(mtime.tv_sec) +
+         "." + std::to_string(mtime.tv_nsec);
+}
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace onnxruntimereactnativejsi {
+
+// Read-only memory mapping of a whole file. Pages are loaded on demand and
+// released when the mapping is destroyed.
+class MappedFile {
+public:
+  // Throws std::runtime_error if the file cannot be opened or mapped.
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  inline const uint8_t *data() const { return data_; }
+  inline size_t size() const { return size_; }
+
+  // Strips a file:// scheme, as passed by file system libraries.
+  static std::string toPath(const std::string &uri);
+
+  // Size and modification time of the file at path, which change whenever
+  // it is rewritten or replaced; empty if it cannot be read.
+  static std::string fileIdentity(const std::string &path);
+
+private:
+  uint8_t *data_;
+  size_t size_;
+};
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,79 @@
+#include "ModelCache.h"
+#include "MappedFile.h"
+#include "Sha256.h"
+#include <atomic>
+#include <cstdio>
+#include <dirent.h>
+#include <onnxruntime_cxx_api.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace onnxruntimereactnativejsi {
+
+ModelCache ModelCache::forFile(const std::string &directory,
+                               const std::string &path,
+                               const std::string &fingerprint) {
+  // A missing file gets an identity of its own; loading it fails anyway.
+  return ModelCache(directory, sha256Hex(path).substr(0, 32),
+                    MappedFile::fileIdentity(path), fingerprint);
+}
+
+ModelCache ModelCache::forBuffer(const std::string &directory,
+                                 const std::string &contentDigest,
+                                 const std::string &fingerprint) {
+  return ModelCache(directory, contentDigest, "", fingerprint);
+}
+
+// Names hold truncated SHA-256 digests, so distinct keys never share one.
+ModelCache::ModelCache(const std::string &directory, const std::string &source,
+                       const std::string &generation,
+                       const std::string &fingerprint)
+    : directory_(directory) {
+  while (directory_.size() > 1 && directory_.back() == '/') {
+    directory_.pop_back();
+  }
+  mkdir(directory_.c_str(), 0700);
+
+  prefix_ = source + "-";
+  generationPrefix_ =
+      prefix_ +
+      sha256Hex(generation + "\n" + OrtGetApiBase()->GetVersionString())
+          .substr(0, 32) +
+      "-";
+  entryPath_ = directory_ + "/" + generationPrefix_ +
+               sha256Hex(fingerprint).substr(0, 32) + ".onnx";
+
+  static std::atomic<uint32_t> nextPending{0};
+  pendingPath_ = entryPath_ + "." + std::to_string(getpid()) + "." +
+                 std::to_string(nextPending++) + ".tmp";
+}
+
+bool ModelCache::hasEntry() const {
+  struct stat st;
+  return stat(entryPath_.c_str(), &st) == 0 && S_ISREG(st.st_mode) &&
+         st.st_size > 0;
+}
+
+void ModelCache::commit() {
+  if (std::rename(pendingPath_.c_str(), entryPath_.c_str()) != 0) {
+    std::remove(pendingPath_.c_str());
+    return;
+  }
+  DIR *dir = opendir(directory_.c_str());
+  if (!dir) {
+    return;
+  }
+  while (auto *entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    // Entries of the same model under other options are kept.
+    if (name.compare(0, prefix_.size(), prefix_) == 0 &&
+        name.compare(0, generationPrefix_.size(), generationPrefix_) != 0) {
+      std::remove((directory_ + "/" + name).c_str());
+    }
+  }
+  closedir(dir);
+}
+
+void ModelCache::discard() { std::remove(entryPath_.c_str()); }
+
+} // namespace onnxruntimereactnativejsi
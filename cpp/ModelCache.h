@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+namespace onnxruntimereactnativejsi {
+
+// One entry of a directory of optimized models. Entries are keyed by the
+// model's identity, the ORT version and a fingerprint of the session options
+// that shape the optimized graph, so any change to those misses the cache.
+// A model file is identified by its path, size and modification time, so a
+// load never has to read it to look up its entry; a buffer, by its content.
+// Entries are grouped by source (the model path, or its content for
+// buffers); committing an entry removes the source's entries for an older
+// model file or ORT version, and keeps those for other options.
+class ModelCache {
+public:
+  static ModelCache forFile(const std::string &directory,
+                            const std::string &path,
+                            const std::string &fingerprint);
+  // contentDigest is the sha256Hex of the model.
+  static ModelCache forBuffer(const std::string &directory,
+                              const std::string &contentDigest,
+                              const std::string &fingerprint);
+
+  // Path of the optimized model, whether or not it exists yet.
+  inline const std::string &entryPath() const { return entryPath_; }
+  bool hasEntry() const;
+
+  // Path ORT should write the optimized model to; commit() publishes it.
+  inline const std::string &pendingPath() const { return pendingPath_; }
+  void commit();
+  // Removes the entry, e.g. when it fails to load.
+  void discard();
+
+private:
+  // Entries are named <source>-<generation>-<options>.onnx, where the
+  // generation changes with the model or the ORT version; only that makes
+  // entries stale.
+  ModelCache(const std::string &directory, const std::string &source,
+             const std::string &generation, const std::string &fingerprint);
+
+  std::string directory_;
+  std::string prefix_;
+  std::string generationPrefix_;
+  std::string entryPath_;
+  std::string pendingPath_;
+};
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,90 @@
+#include "OrtValueHostObject.h"
+#include "TensorUtils.h"
+
+using namespace facebook::jsi;
+
+namespace onnxruntimereactnativejsi {
+
+OrtValueHostObject::OrtValueHostObject(std::shared_ptr<Env> env,
+                                       std::shared_ptr<Ort::Value> value)
+    : JsiHostObject(
+          {
+              METHOD_INFO(OrtValueHostObject, toTensor, 0),
+              METHOD_INFO(OrtValueHostObject, dispose, 0),
+          },
+          {
+              GETTER_INFO(OrtValueHostObject, type),
+              GETTER_INFO(OrtValueHostObject, dims),
+              GETTER_INFO(OrtValueHostObject, size),
+              GETTER_INFO(OrtValueHostObject, data),
+              GETTER_INFO(OrtValueHostObject, isDisposed),
+          }),
+      env_(env), value_(value) {}
+
+std::shared_ptr<Ort::Value>
+OrtValueHostObject::getValue(Runtime &runtime, const Object &object) {
+  if (!object.isHostObject<OrtValueHostObject>(runtime)) {
+    return nullptr;
+  }
+  auto hostObject = object.getHostObject<OrtValueHostObject>(runtime);
+  if (!hostObject->value_) {
+    throw JSError(runtime, "Tensor is disposed");
+  }
+  return hostObject->value_;
+}
+
+Ort::Value &OrtValueHostObject::assertValue(Runtime &runtime) {
+  if (!value_) {
+    throw JSError(runtime, "Tensor is disposed");
+  }
+  return *value_;
+}
+
+DEFINE_GETTER(OrtValueHostObject::type) {
+  auto elementType =
+      assertValue(runtime).GetTensorTypeAndShapeInfo().GetElementType();
+  return TensorUtils::getTypeName(runtime, *env_, elementType);
+}
+
+DEFINE_GETTER(OrtValueHostObject::dims) {
+  auto shape = assertValue(runtime).GetTensorTypeAndShapeInfo().GetShape();
+  auto dims = Array(runtime, shape.size());
+  for (size_t i = 0; i < shape.size(); ++i) {
+    dims.setValueAtIndex(runtime, i, Value(static_cast<double>(shape[i])));
+  }
+  return dims;
+}
+
+DEFINE_GETTER(OrtValueHostObject::size) {
+  return Value(static_cast<double>(
+      assertValue(runtime).GetTensorTypeAndShapeInfo().GetElementCount()));
+}
+
+// The TypedArray aliases the native memory and shares ownership of it, so it
+// stays valid after dispose().
+DEFINE_GETTER(OrtValueHostObject::data) {
+  assertValue(runtime);
+  if (!data_) {
+    data_ = std::make_shared<Value>(
+        TensorUtils::createTypedArrayFromOrtValue(runtime, *env_, value_));
+  }
+  return Value(runtime, *data_);
+}
+
+DEFINE_GETTER(OrtValueHostObject::isDisposed) { return Value(!value_); }
+
+DEFINE_METHOD(OrtValueHostObject::toTensor) {
+  assertValue(runtime);
+  auto tensorConstructor =
+      env_->getTensorConstructor(runtime).asObject(runtime);
+  return TensorUtils::createJSTensorFromOrtValue(runtime, *env_, value_,
+                                                 tensorConstructor);
+}
+
+DEFINE_METHOD(OrtValueHostObject::dispose) {
+  value_.reset();
+  data_.reset();
+  return Value::undefined();
+}
+
+} // namespace onnxruntimereactnativejsi
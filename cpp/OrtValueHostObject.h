@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Env.h"
+#include "JsiHelper.hpp"
+#include <jsi/jsi.h>
+#include <memory>
+#include <onnxruntime_cxx_api.h>
+
+using namespace facebook::jsi;
+
+namespace onnxruntimereactnativejsi {
+
+// A tensor that stays in native memory. Returned by run() for fetches
+// marked 'native' and accepted as a feed, so values passed between models
+// never round-trip through JS. Its data only reaches JS when read.
+class OrtValueHostObject : public JsiHostObject {
+public:
+  OrtValueHostObject(std::shared_ptr<Env> env,
+                     std::shared_ptr<Ort::Value> value);
+
+  // Returns the wrapped value if object is an OrtValueHostObject, or nullptr.
+  static std::shared_ptr<Ort::Value> getValue(Runtime &runtime,
+                                              const Object &object);
+
+private:
+  Ort::Value &assertValue(Runtime &runtime);
+
+  std::shared_ptr<Env> env_;
+  std::shared_ptr<Ort::Value> value_;
+  std::shared_ptr<Value> data_;
+
+  DEFINE_METHOD(toTensor);
+  DEFINE_METHOD(dispose);
+
+  DEFINE_GETTER(type);
+  DEFINE_GETTER(dims);
+  DEFINE_GETTER(size);
+  DEFINE_GETTER(data);
+  DEFINE_GETTER(isDisposed);
+};
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,249 @@
+#include "ProfileSummary.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace onnxruntimereactnativejsi {
+
+namespace {
+
+// The fields of one trace event this summary uses.
+struct Event {
+  std::string cat;
+  std::string name;
+  double ts = 0;
+  double dur = 0;
+  std::string opName;
+  std::string provider;
+};
+
+// Just enough JSON to walk ORT's trace: an array of flat event objects with
+// an `args` object. Values the summary does not use are skipped.
+class TraceParser {
+public:
+  explicit TraceParser(const std::string &text) : text_(text), pos_(0) {}
+
+  template <typename Callback> void forEachEvent(Callback &&callback) {
+    expect('[');
+    if (consume(']')) {
+      return;
+    }
+    do {
+      callback(parseEvent());
+    } while (consume(','));
+    expect(']');
+  }
+
+private:
+  Event parseEvent() {
+    Event event;
+    parseObject([&](const std::string &key) {
+      if (key == "cat") {
+        event.cat = parseString();
+      } else if (key == "name") {
+        event.name = parseString();
+      } else if (key == "ts") {
+        event.ts = parseNumber();
+      } else if (key == "dur") {
+        event.dur = parseNumber();
+      } else if (key == "args" && peek() == '{') {
+        parseObject([&](const std::string &arg) {
+          if (arg == "op_name") {
+            event.opName = parseString();
+          } else if (arg == "provider") {
+            event.provider = parseString();
+          } else {
+            skipValue();
+          }
+        });
+      } else {
+        skipValue();
+      }
+    });
+    return event;
+  }
+
+  template <typename Callback> void parseObject(Callback &&onKey) {
+    expect('{');
+    if (consume('}')) {
+      return;
+    }
+    do {
+      auto key = parseString();
+      expect(':');
+      onKey(key);
+    } while (consume(','));
+    expect('}');
+  }
+
+  void skipValue() {
+    switch (peek()) {
+    case '{':
+      parseObject([&](const std::string &) { skipValue(); });
+      break;
+    case '[':
+      expect('[');
+      if (!consume(']')) {
+        do {
+          skipValue();
+        } while (consume(','));
+        expect(']');
+      }
+      break;
+    case '"':
+      parseString();
+      break;
+    default:
+      // Numbers and literals run until the next delimiter.
+      while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' &&
+             text_[pos_] != ']') {
+        ++pos_;
+      }
+    }
+  }
+
+  std::string parseString() {
+    expect('"');
+    std::string result;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c == '\\' && pos_ < text_.size()) {
+        char escaped = text_[pos_++];
+        switch (escaped) {
+        case 'n':
+          result += '\n';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u':
+          // Names are ASCII in practice; keep the escape as written.
+          result += "\\u";
+          break;
+        default:
+          result += escaped;
+        }
+      } else {
+        result += c;
+      }
+    }
+    expect('"');
+    return result;
+  }
+
+  double parseNumber() {
+    skipSpace();
+    const char *start = text_.c_str() + pos_;
+    char *end = nullptr;
+    double value = std::strtod(start, &end);
+    if (end == start) {
+      fail();
+    }
+    pos_ += end - start;
+    return value;
+  }
+
+  char peek() {
+    skipSpace();
+    return pos_ < text_.size() ? text_[pos_] : '\0';
+  }
+
+  bool consume(char c) {
+    if (peek() != c) {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  void expect(char c) {
+    if (!consume(c)) {
+      fail();
+    }
+  }
+
+  void skipSpace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' ||
+            text_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  [[noreturn]] void fail() {
+    throw std::runtime_error("Malformed profile at offset " +
+                             std::to_string(pos_));
+  }
+
+  const std::string &text_;
+  size_t pos_;
+};
+
+const std::string kKernelTimeSuffix = "_kernel_time";
+
+} // namespace
+
+ProfileSummary ProfileSummary::fromFile(const std::string &path,
+                                        double fromUs) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Failed to open profile " + path);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto text = buffer.str();
+
+  ProfileSummary summary;
+  std::unordered_map<std::string, size_t> nodeIndices;
+  std::unordered_map<std::string, size_t> opTypeIndices;
+  TraceParser(text).forEachEvent([&](const Event &event) {
+    if (event.ts < fromUs) {
+      return;
+    }
+    if (event.cat == "Session" && event.name == "model_run") {
+      ++summary.runs;
+      summary.runTotalUs += event.dur;
+      return;
+    }
+    // Each node reports fence, kernel and fence events; only the kernel
+    // time is the node's own.
+    if (event.cat != "Node" || event.name.size() <= kKernelTimeSuffix.size() ||
+        event.name.compare(event.name.size() - kKernelTimeSuffix.size(),
+                           kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0) {
+      return;
+    }
+    auto name =
+        event.name.substr(0, event.name.size() - kKernelTimeSuffix.size());
+    auto node = nodeIndices.emplace(name, summary.nodes.size());
+    if (node.second) {
+      summary.nodes.push_back({name, event.opName, event.provider});
+    }
+    auto &nodeTotals = summary.nodes[node.first->second];
+    ++nodeTotals.count;
+    nodeTotals.totalUs += event.dur;
+
+    auto opType = opTypeIndices.emplace(event.opName, summary.opTypes.size());
+    if (opType.second) {
+      summary.opTypes.push_back({event.opName});
+    }
+    auto &opTypeTotals = summary.opTypes[opType.first->second];
+    ++opTypeTotals.count;
+    opTypeTotals.totalUs += event.dur;
+    if (std::find(opTypeTotals.providers.begin(), opTypeTotals.providers.end(),
+                  event.provider) == opTypeTotals.providers.end()) {
+      opTypeTotals.providers.push_back(event.provider);
+    }
+  });
+
+  std::sort(summary.nodes.begin(), summary.nodes.end(),
+            [](const Node &a, const Node &b) { return a.totalUs > b.totalUs; });
+  std::sort(
+      summary.opTypes.begin(), summary.opTypes.end(),
+      [](const OpType &a, const OpType &b) { return a.totalUs > b.totalUs; });
+  return summary;
+}
+
+} // namespace onnxruntimereactnativejsi
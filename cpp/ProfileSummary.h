@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace onnxruntimereactnativejsi {
+
+// Totals of the node events in an ORT profile (Chrome trace JSON), per node
+// and per op type, so hot operators can be found without the file.
+struct ProfileSummary {
+  struct Node {
+    std::string name;
+    std::string opType;
+    // Execution provider the node was assigned to.
+    std::string provider;
+    size_t count = 0;
+    double totalUs = 0;
+  };
+
+  struct OpType {
+    std::string opType;
+    std::vector<std::string> providers;
+    size_t count = 0;
+    double totalUs = 0;
+  };
+
+  // Both sorted by total time, longest first.
+  std::vector<Node> nodes;
+  std::vector<OpType> opTypes;
+  size_t runs = 0;
+  double runTotalUs = 0;
+
+  // Summarizes the events of the profile at path that start at or after
+  // fromUs, in the profile's own time base. Throws std::runtime_error if the
+  // file cannot be read or parsed.
+  static ProfileSummary fromFile(const std::string &path, double fromUs);
+};
+
+} // namespace onnxruntimereactnativejsi
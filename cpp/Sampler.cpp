@@ -0,0 +1,85 @@
+#include "Sampler.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace onnxruntimereactnativejsi {
+
+Sampler::Sampler(const Options &options)
+    : options_(options), rng_(options.seed) {}
+
+int64_t Sampler::sample(float *logits, size_t vocabSize,
+                        const std::vector<int64_t> &history) {
+  if (options_.repetitionPenalty != 1.0f) {
+    // history repeats tokens; each logit is penalized once.
+    penalized_.assign(vocabSize, false);
+    for (auto token : history) {
+      if (token < 0 || static_cast<size_t>(token) >= vocabSize ||
+          penalized_[token]) {
+        continue;
+      }
+      penalized_[token] = true;
+      auto &logit = logits[token];
+      logit = logit > 0 ? logit / options_.repetitionPenalty
+                        : logit * options_.repetitionPenalty;
+    }
+  }
+
+  if (!options_.doSample || options_.temperature <= 0.0f ||
+      options_.topK == 1) {
+    return std::max_element(logits, logits + vocabSize) - logits;
+  }
+
+  size_t candidates = vocabSize;
+  if (options_.topK > 0 && options_.topK < vocabSize) {
+    candidates = options_.topK;
+  }
+  indices_.resize(vocabSize);
+  std::iota(indices_.begin(), indices_.end(), 0);
+  auto byLogit = [logits](size_t a, size_t b) { return logits[a] > logits[b]; };
+  if (candidates < vocabSize) {
+    std::partial_sort(indices_.begin(), indices_.begin() + candidates,
+                      indices_.end(), byLogit);
+  } else if (options_.topP < 1.0f) {
+    std::sort(indices_.begin(), indices_.end(), byLogit);
+  }
+
+  // Softmax over the candidates, with the temperature applied.
+  float maxLogit = logits[indices_[0]];
+  for (size_t i = 1; i < candidates; ++i) {
+    maxLogit = std::max(maxLogit, logits[indices_[i]]);
+  }
+  probs_.resize(candidates);
+  float sum = 0.0f;
+  for (size_t i = 0; i < candidates; ++i) {
+    probs_[i] =
+        std::exp((logits[indices_[i]] - maxLogit) / options_.temperature);
+    sum += probs_[i];
+  }
+
+  // Candidates are sorted by probability here whenever topP is active.
+  if (options_.topP < 1.0f) {
+    float cumulative = 0.0f;
+    size_t kept = 0;
+    while (kept < candidates) {
+      cumulative += probs_[kept++] / sum;
+      if (cumulative >= options_.topP) {
+        break;
+      }
+    }
+    candidates = kept;
+    sum = std::accumulate(probs_.begin(), probs_.begin() + candidates, 0.0f);
+  }
+
+  std::uniform_real_distribution<float> distribution(0.0f, sum);
+  float target = distribution(rng_);
+  for (size_t i = 0; i < candidates; ++i) {
+    target -= probs_[i];
+    if (target <= 0.0f) {
+      return indices_[i];
+    }
+  }
+  return indices_[candidates - 1];
+}
+
+} // namespace onnxruntimereactnativejsi
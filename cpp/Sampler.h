@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace onnxruntimereactnativejsi {
+
+// Picks the next token from a row of logits for autoregressive generation.
+class Sampler {
+public:
+  struct Options {
+    // Greedy decoding when false; temperature, topK and topP are ignored.
+    bool doSample = false;
+    float temperature = 1.0f;
+    // Keep only the k most likely tokens; 0 disables.
+    size_t topK = 0;
+    // Keep the smallest set of tokens whose probability reaches p; 1 disables.
+    float topP = 1.0f;
+    // CTRL-style penalty for tokens already in the sequence; 1 disables.
+    float repetitionPenalty = 1.0f;
+    uint32_t seed = 0;
+  };
+
+  explicit Sampler(const Options &options);
+
+  // logits is modified in place. history holds every token of the sequence
+  // so far, prompt included.
+  int64_t sample(float *logits, size_t vocabSize,
+                 const std::vector<int64_t> &history);
+
+private:
+  Options options_;
+  std::mt19937 rng_;
+  std::vector<size_t> indices_;
+  std::vector<float> probs_;
+  std::vector<bool> penalized_;
+};
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,82 @@
+#include "SessionRegistry.h"
+
+namespace onnxruntimereactnativejsi {
+
+// Only the registry hands out references, under the lock, so an idle
+// session cannot become busy while it is being evicted.
+static bool isIdle(const std::shared_ptr<Ort::Session> &session) {
+  return session.use_count() == 1;
+}
+
+std::shared_ptr<Ort::Session>
+SessionRegistry::acquire(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->session;
+}
+
+std::shared_ptr<Ort::Session>
+SessionRegistry::insert(const std::string &key,
+                        std::shared_ptr<Ort::Session> session, size_t bytes) {
+  std::vector<std::shared_ptr<Ort::Session>> evicted;
+  std::shared_ptr<Ort::Session> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      evicted.push_back(std::move(session));
+      return it->second->session;
+    }
+    entries_.push_front({key, session, bytes});
+    index_[key] = entries_.begin();
+    bytes_ += bytes;
+    result = std::move(session);
+    trimLocked(evicted);
+  }
+  return result;
+}
+
+void SessionRegistry::setBudget(size_t bytes) {
+  std::vector<std::shared_ptr<Ort::Session>> evicted;
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = bytes;
+  trimLocked(evicted);
+}
+
+void SessionRegistry::trim() {
+  std::vector<std::shared_ptr<Ort::Session>> evicted;
+  std::lock_guard<std::mutex> lock(mutex_);
+  trimLocked(evicted);
+}
+
+SessionRegistry::Stats SessionRegistry::getStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats{entries_.size(), 0, bytes_, budget_};
+  for (const auto &entry : entries_) {
+    if (isIdle(entry.session)) {
+      ++stats.idleSessions;
+    }
+  }
+  return stats;
+}
+
+void SessionRegistry::trimLocked(
+    std::vector<std::shared_ptr<Ort::Session>> &evicted) {
+  for (auto it = entries_.end(); bytes_ > budget_ && it != entries_.begin();) {
+    --it;
+    if (!isIdle(it->session)) {
+      continue;
+    }
+    bytes_ -= it->bytes;
+    evicted.push_back(std::move(it->session));
+    index_.erase(it->key);
+    it = entries_.erase(it);
+  }
+}
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <onnxruntime_cxx_api.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace onnxruntimereactnativejsi {
+
+// Loaded sessions keyed by model identity and options, so loading a model
+// that is already loaded shares its Ort::Session. A session is in use while
+// anyone besides the registry holds a reference to it. Idle sessions are
+// kept for reuse until the registered sessions exceed the memory budget,
+// then evicted least recently used first. Thread safe.
+class SessionRegistry {
+public:
+  struct Stats {
+    size_t sessions;
+    size_t idleSessions;
+    size_t bytes;
+    size_t budget;
+  };
+
+  // Returns the session registered under key, or null.
+  std::shared_ptr<Ort::Session> acquire(const std::string &key);
+
+  // Registers session under key, with bytes as its estimated footprint. If
+  // a concurrent load registered the key first, that session is returned
+  // instead and session is dropped.
+  std::shared_ptr<Ort::Session> insert(const std::string &key,
+                                       std::shared_ptr<Ort::Session> session,
+                                       size_t bytes);
+
+  // 0, the default, keeps no idle sessions.
+  void setBudget(size_t bytes);
+
+  // Evicts idle sessions while over budget. Call after releasing a session.
+  void trim();
+
+  Stats getStats();
+
+private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<Ort::Session> session;
+    size_t bytes;
+  };
+
+  // Moves evicted sessions into evicted, to be destroyed outside the lock.
+  void trimLocked(std::vector<std::shared_ptr<Ort::Session>> &evicted);
+
+  std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t bytes_ = 0;
+  size_t budget_ = 0;
+};
+
+} // namespace onnxruntimereactnativejsi
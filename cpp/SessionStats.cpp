@@ -0,0 +1,117 @@
+#include "SessionStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace onnxruntimereactnativejsi {
+
+int64_t LatencyHistogram::nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void LatencyHistogram::record(double ms, int64_t nowNs) {
+  double us = ms * 1000;
+  size_t index = 0;
+  if (us >= 1) {
+    index = static_cast<size_t>(std::log2(us) * kSubBuckets);
+    if (index >= kBuckets) {
+      index = kBuckets - 1;
+    }
+  }
+  auto period = nowNs / kSliceNs;
+  auto &slice = slices_[period % kSlices];
+  auto sliced = slice.period.load(std::memory_order_acquire);
+  // The first sample of a period recycles the slice. A sample recorded by
+  // another thread while it is cleared may be lost.
+  if (sliced < period &&
+      slice.period.compare_exchange_strong(sliced, period,
+                                           std::memory_order_acq_rel)) {
+    for (auto &bucket : slice.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+  slice.buckets[index].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::percentile(double p, int64_t nowNs) const {
+  // Counts are read bucket by bucket; a concurrent record() may or may not
+  // be seen, which only shifts the result by one sample.
+  auto period = nowNs / kSliceNs;
+  std::array<uint64_t, kBuckets> counts{};
+  uint64_t total = 0;
+  for (const auto &slice : slices_) {
+    if (!inWindow(slice, period)) {
+      continue;
+    }
+    for (size_t i = 0; i < kBuckets; ++i) {
+      auto n = slice.buckets[i].load(std::memory_order_relaxed);
+      counts[i] += n;
+      total += n;
+    }
+  }
+  if (total == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(std::ceil(p * total));
+  if (target == 0) {
+    target = 1;
+  }
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += counts[i];
+    if (seen >= target) {
+      return std::exp2(static_cast<double>(i + 1) / kSubBuckets) / 1000;
+    }
+  }
+  return std::exp2(static_cast<double>(kBuckets) / kSubBuckets) / 1000;
+}
+
+uint64_t LatencyHistogram::recentCount(int64_t nowNs) const {
+  auto period = nowNs / kSliceNs;
+  uint64_t total = 0;
+  for (const auto &slice : slices_) {
+    if (!inWindow(slice, period)) {
+      continue;
+    }
+    for (const auto &bucket : slice.buckets) {
+      total += bucket.load(std::memory_order_relaxed);
+    }
+  }
+  return total;
+}
+
+void LatencyHistogram::reset() {
+  for (auto &slice : slices_) {
+    slice.period.store(-1, std::memory_order_relaxed);
+    for (auto &bucket : slice.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+  count_.store(0, std::memory_order_relaxed);
+}
+
+void SessionStats::reset() {
+  queueMs.reset();
+  runMs.reset();
+  marshalMs.reset();
+  runs.store(0, std::memory_order_relaxed);
+  errors.store(0, std::memory_order_relaxed);
+  cancels.store(0, std::memory_order_relaxed);
+  bytesIn.store(0, std::memory_order_relaxed);
+  bytesOut.store(0, std::memory_order_relaxed);
+  resetAtNs_.store(LatencyHistogram::nowNs(), std::memory_order_relaxed);
+}
+
+double SessionStats::runsPerSecond(int64_t nowNs) const {
+  auto startNs = std::max(LatencyHistogram::windowStartNs(nowNs),
+                          resetAtNs_.load(std::memory_order_relaxed));
+  if (nowNs <= startNs) {
+    return 0;
+  }
+  return runMs.recentCount(nowNs) * 1e9 / (nowNs - startNs);
+}
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace onnxruntimereactnativejsi {
+
+// Latency histogram with logarithmic buckets, eight per doubling, from 1us
+// to over an hour. Recording is lock-free, so it can run on every call.
+// Samples are kept in six 10s slices that are recycled as time moves on, so
+// percentiles describe roughly the last minute rather than the whole
+// lifetime; count() still covers every sample since the last reset.
+class LatencyHistogram {
+public:
+  static constexpr int64_t kSliceNs = 10'000'000'000;
+  static constexpr size_t kSlices = 6;
+
+  inline void record(double ms) { record(ms, nowNs()); }
+  void record(double ms, int64_t nowNs);
+
+  // Upper bound of the bucket holding the p-th quantile (0 < p <= 1) of the
+  // samples in the window, so within about 9% of the true value. 0 while
+  // the window is empty.
+  inline double percentile(double p) const { return percentile(p, nowNs()); }
+  double percentile(double p, int64_t nowNs) const;
+
+  inline uint64_t count() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+  // Samples in the window.
+  uint64_t recentCount(int64_t nowNs) const;
+
+  // Start of the window that ends at nowNs, between 50s and 60s before it.
+  static inline int64_t windowStartNs(int64_t nowNs) {
+    return (nowNs / kSliceNs - static_cast<int64_t>(kSlices) + 1) * kSliceNs;
+  }
+
+  // Not atomic with respect to concurrent record() calls, which may land
+  // on either side of the reset.
+  void reset();
+
+  static int64_t nowNs();
+
+private:
+  static constexpr int kSubBuckets = 8;
+  static constexpr size_t kBuckets = 32 * kSubBuckets;
+
+  struct Slice {
+    // Index of the 10s period the counts belong to; -1 while unused.
+    std::atomic<int64_t> period{-1};
+    std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+  };
+
+  // Whether the slice holds samples of the window ending in `period`.
+  static inline bool inWindow(const Slice &slice, int64_t period) {
+    auto sliced = slice.period.load(std::memory_order_acquire);
+    return sliced >= 0 && sliced > period - static_cast<int64_t>(kSlices) &&
+           sliced <= period;
+  }
+
+  std::array<Slice, kSlices> slices_{};
+  std::atomic<uint64_t> count_{0};
+};
+
+// Run statistics of one session. Counters are cumulative since the last
+// reset; latency percentiles and runsPerSecond() cover the histograms'
+// window.
+struct SessionStats {
+  LatencyHistogram queueMs;
+  LatencyHistogram runMs;
+  // Converting feeds and fetches to and from JS.
+  LatencyHistogram marshalMs;
+  std::atomic<uint64_t> runs{0};
+  std::atomic<uint64_t> errors{0};
+  // Runs rejected without running, e.g. past their deadline.
+  std::atomic<uint64_t> cancels{0};
+  std::atomic<uint64_t> bytesIn{0};
+  std::atomic<uint64_t> bytesOut{0};
+
+  SessionStats() { reset(); }
+
+  void reset();
+  // Completed runs per second over the window, or since the last reset if
+  // that is more recent. Each run records one runMs sample.
+  inline double runsPerSecond() const {
+    return runsPerSecond(LatencyHistogram::nowNs());
+  }
+  double runsPerSecond(int64_t nowNs) const;
+
+private:
+  std::atomic<int64_t> resetAtNs_{0};
+};
+
+} // namespace onnxruntimereactnativejsi
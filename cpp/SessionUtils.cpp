@@ -1,6 +1,9 @@
 #include "SessionUtils.h"
 #include "JsiUtils.h"
+#include "MappedFile.h"
+#include <cctype>
 #include <cpu_provider_factory.h>
+#include <cstdlib>
 #include <jsi/jsi.h>
 #include <onnxruntime_cxx_api.h>
 #ifdef USE_NNAPI
@@ -54,8 +57,10 @@ public:
 #endif
 };
 
-void parseSessionOptions(Runtime &runtime, const Value &optionsValue,
-                         Ort::SessionOptions &sessionOptions) {
+void parseSessionOptions(Runtime &runtime, Env &env,
+                         const Value &optionsValue,
+                         Ort::SessionOptions &sessionOptions,
+                         SessionResources &resources) {
   if (!optionsValue.isObject())
     return;
 
@@ -211,6 +216,15 @@ void parseSessionOptions(Runtime &runtime, const Value &optionsValue,
         std::vector<std::string> paths;
         std::vector<char *> buffs;
         std::vector<size_t> sizes;
+        // Mapped files are handed to ORT like in-memory buffers, without
+        // ever being read into the JS heap.
+        auto mapFile = [&](const std::string &uri) {
+          auto file = std::make_shared<MappedFile>(MappedFile::toPath(uri));
+          buffs.push_back(
+              reinterpret_cast<char *>(const_cast<uint8_t *>(file->data())));
+          sizes.push_back(file->size());
+          resources.mappedFiles.push_back(file);
+        };
         forEach(
             runtime, externalDataArray, [&](const Value &value, size_t index) {
               if (value.isObject()) {
@@ -224,17 +238,24 @@ void parseSessionOptions(Runtime &runtime, const Value &optionsValue,
                 }
                 if (externalDataObject.hasProperty(runtime, "data")) {
                   auto dataValue =
-                      externalDataObject.getProperty(runtime, "data")
-                          .asObject(runtime);
-                  if (isTypedArray(runtime, dataValue)) {
-                    auto arrayBuffer = dataValue.getProperty(runtime, "buffer")
-                                           .asObject(runtime)
-                                           .getArrayBuffer(runtime);
-                    buffs.push_back(
-                        reinterpret_cast<char *>(arrayBuffer.data(runtime)));
-                    sizes.push_back(arrayBuffer.size(runtime));
+                      externalDataObject.getProperty(runtime, "data");
+                  if (dataValue.isString()) {
+                    mapFile(dataValue.asString(runtime).utf8(runtime));
+                  } else if (dataValue.isObject() &&
+                             isTypedArray(runtime,
+                                          dataValue.asObject(runtime))) {
+                    size_t byteLength = 0;
+                    auto data = getTypedArrayData(
+                        runtime, dataValue.asObject(runtime), byteLength);
+                    buffs.push_back(reinterpret_cast<char *>(data));
+                    sizes.push_back(byteLength);
                   }
                 }
+              } else if (value.isString()) {
+                // A bare file path, referenced by the model by its file name.
+                auto path = value.asString(runtime).utf8(runtime);
+                paths.push_back(path.substr(path.find_last_of('/') + 1));
+                mapFile(path);
               }
             });
         sessionOptions.AddExternalInitializersFromFilesInMemory(paths, buffs,
@@ -242,6 +263,55 @@ void parseSessionOptions(Runtime &runtime, const Value &optionsValue,
       }
     }
 
+    // useGlobalThreadPools
+    if (options.hasProperty(runtime, "useGlobalThreadPools")) {
+      auto prop = options.getProperty(runtime, "useGlobalThreadPools");
+      if (prop.isBool() && prop.asBool()) {
+        if (!env.getGlobalThreadPools()) {
+          throw JSError(runtime, "Global thread pools are not enabled");
+        }
+        sessionOptions.DisablePerSessionThreads();
+      }
+    }
+
+    // useSharedArena
+    if (options.hasProperty(runtime, "useSharedArena")) {
+      auto prop = options.getProperty(runtime, "useSharedArena");
+      if (prop.isBool() && prop.asBool()) {
+        if (!env.hasSharedArena()) {
+          throw JSError(runtime, "Shared CPU arena is not enabled");
+        }
+        sessionOptions.AddConfigEntry("session.use_env_allocators", "1");
+        resources.sharedArena = true;
+      }
+    }
+
+    // sharedInitializers
+    if (options.hasProperty(runtime, "sharedInitializers")) {
+      auto prop = options.getProperty(runtime, "sharedInitializers");
+      if (prop.isObject() && prop.asObject(runtime).isArray(runtime)) {
+        forEach(runtime, prop.asObject(runtime).asArray(runtime),
+                [&](const Value &nameValue, size_t index) {
+                  auto name = nameValue.asString(runtime).utf8(runtime);
+                  auto value = env.getSharedInitializer(name);
+                  if (!value) {
+                    throw JSError(runtime,
+                                  "Unknown shared initializer: " + name);
+                  }
+                  sessionOptions.AddInitializer(name.c_str(), *value);
+                  resources.initializers.push_back(value);
+                });
+      }
+    }
+
+    // sharePrepackedWeights
+    if (options.hasProperty(runtime, "sharePrepackedWeights")) {
+      auto prop = options.getProperty(runtime, "sharePrepackedWeights");
+      if (prop.isBool()) {
+        resources.sharePrepackedWeights = prop.asBool();
+      }
+    }
+
     // executionProviders
     if (options.hasProperty(runtime, "executionProviders")) {
       auto prop = options.getProperty(runtime, "executionProviders");
@@ -413,10 +483,52 @@ void parseRunOptions(Runtime &runtime, const Value &optionsValue,
       }
     }
 
+    // shrinkArena: return the CPU arena's free regions to the system after
+    // the run, e.g. after a burst of unusually large inputs.
+    if (options.hasProperty(runtime, "shrinkArena")) {
+      auto prop = options.getProperty(runtime, "shrinkArena");
+      if (prop.isBool() && prop.asBool()) {
+        runOptions.AddConfigEntry("memory.enable_memory_arena_shrinkage",
+                                  "cpu:0");
+      }
+    }
+
   } catch (const std::exception &e) {
     throw JSError(runtime,
                   "Failed to parse run options: " + std::string(e.what()));
   }
 }
 
+std::map<std::string, double> getAllocatorStats(const Ort::Session &session) {
+  std::map<std::string, double> stats;
+  try {
+    auto memoryInfo =
+        Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    Ort::Allocator allocator(session, memoryInfo);
+    for (const auto &entry : allocator.GetStats().GetKeyValuePairs()) {
+      auto key = entry.first;
+      if (!key.empty()) {
+        key[0] = static_cast<char>(std::tolower(key[0]));
+      }
+      stats[key] = std::strtod(entry.second.c_str(), nullptr);
+    }
+  } catch (const Ort::Exception &) {
+    // Allocators without stats report an error rather than empty stats.
+    stats.clear();
+  }
+  return stats;
+}
+
+Value createAllocatorStats(Runtime &runtime,
+                           const std::map<std::string, double> &stats) {
+  if (stats.empty()) {
+    return Value::null();
+  }
+  auto result = Object(runtime);
+  for (const auto &entry : stats) {
+    result.setProperty(runtime, entry.first.c_str(), entry.second);
+  }
+  return Value(runtime, result);
+}
+
 } // namespace onnxruntimereactnativejsi
\ No newline at end of file
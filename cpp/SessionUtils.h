@@ -1,18 +1,46 @@
 #pragma once
 
+#include "Env.h"
+#include "MappedFile.h"
 #include <jsi/jsi.h>
+#include <map>
+#include <memory>
 #include <onnxruntime_cxx_api.h>
+#include <string>
+#include <vector>
 
 namespace onnxruntimereactnativejsi {
 
 extern const std::vector<const char *> supportedBackends;
 
-void parseSessionOptions(facebook::jsi::Runtime &runtime,
+// Native state the parsed options refer to. It must outlive the session.
+struct SessionResources {
+  // Files mapped for externalData.
+  std::vector<std::shared_ptr<MappedFile>> mappedFiles;
+  // Env initializers named in sharedInitializers.
+  std::vector<std::shared_ptr<Ort::Value>> initializers;
+  // Whether to create the session with the Env's prepacked weights.
+  bool sharePrepackedWeights = false;
+  // Whether the session allocates from the Env's shared CPU arena.
+  bool sharedArena = false;
+};
+
+void parseSessionOptions(facebook::jsi::Runtime &runtime, Env &env,
                          const facebook::jsi::Value &optionsValue,
-                         Ort::SessionOptions &sessionOptions);
+                         Ort::SessionOptions &sessionOptions,
+                         SessionResources &resources);
 
 void parseRunOptions(facebook::jsi::Runtime &runtime,
                      const facebook::jsi::Value &optionsValue,
                      Ort::RunOptions &runOptions);
 
+// Counters of the session's CPU allocator as ORT reports them (Limit,
+// InUse, TotalAllocated, MaxInUse, NumAllocs, ...), with camelCase keys.
+// Empty if the allocator keeps none, e.g. with the arena disabled.
+std::map<std::string, double> getAllocatorStats(const Ort::Session &session);
+
+facebook::jsi::Value
+createAllocatorStats(facebook::jsi::Runtime &runtime,
+                     const std::map<std::string, double> &stats);
+
 } // namespace onnxruntimereactnativejsi
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace onnxruntimereactnativejsi {
+
+// SHA-256 of data as 64 lowercase hex digits. Used where a hash stands in
+// for content, e.g. to recognize an in-memory model, so a collision must be
+// out of the question.
+std::string sha256Hex(const uint8_t *data, size_t size);
+
+inline std::string sha256Hex(const std::string &value) {
+  return sha256Hex(reinterpret_cast<const uint8_t *>(value.data()),
+                   value.size());
+}
+
+} // namespace onnxruntimereactnativejsi
@@ -8,88 +8,134 @@ using namespace facebook::jsi;
 
 namespace onnxruntimereactnativejsi {
 
-static const std::unordered_map<ONNXTensorElementDataType, const char *>
-    dataTypeToStringMap = {
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, "float32"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8, "uint8"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8, "int8"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16, "uint16"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16, "int16"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32, "int32"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, "int64"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING, "string"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL, "bool"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16, "float16"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE, "float64"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32, "uint32"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64, "uint64"},
+struct DataTypeInfo {
+  const char *name;
+  size_t elementSize;
+  const char *typedArray;
 };
 
-static const std::unordered_map<ONNXTensorElementDataType, size_t>
-    elementSizeMap = {
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, sizeof(float)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8, sizeof(uint8_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8, sizeof(int8_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16, sizeof(uint16_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16, sizeof(int16_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32, sizeof(int32_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, sizeof(int64_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING, sizeof(char *)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL, sizeof(bool)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16, 2},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE, sizeof(double)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32, sizeof(uint32_t)},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64, sizeof(uint64_t)},
+// Indexed by ONNXTensorElementDataType. Unsupported types have no name.
+static const DataTypeInfo dataTypeInfos[] = {
+    {nullptr, 0, nullptr},                          // UNDEFINED
+    {"float32", sizeof(float), "Float32Array"},     // FLOAT
+    {"uint8", sizeof(uint8_t), "Uint8Array"},       // UINT8
+    {"int8", sizeof(int8_t), "Int8Array"},          // INT8
+    {"uint16", sizeof(uint16_t), "Uint16Array"},    // UINT16
+    {"int16", sizeof(int16_t), "Int16Array"},       // INT16
+    {"int32", sizeof(int32_t), "Int32Array"},       // INT32
+    {"int64", sizeof(int64_t), "BigInt64Array"},    // INT64
+    {"string", sizeof(char *), "Array"},            // STRING
+    {"bool", sizeof(bool), "Uint8Array"},           // BOOL
+    {"float16", 2, "Float16Array"},                 // FLOAT16
+    {"float64", sizeof(double), "Float64Array"},    // DOUBLE
+    {"uint32", sizeof(uint32_t), "Uint32Array"},    // UINT32
+    {"uint64", sizeof(uint64_t), "BigUint64Array"}, // UINT64
 };
 
-static const std::unordered_map<ONNXTensorElementDataType, const char *>
-    dataTypeToTypedArrayMap = {
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, "Float32Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE, "Float64Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32, "Int32Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, "BigInt64Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32, "Uint32Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64, "BigUint64Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8, "Uint8Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8, "Int8Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16, "Uint16Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16, "Int16Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16, "Float16Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING, "Array"},
-        {ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL, "Uint8Array"},
+static constexpr size_t dataTypeCount =
+    sizeof(dataTypeInfos) / sizeof(dataTypeInfos[0]);
+
+static_assert(ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64 == dataTypeCount - 1,
+              "dataTypeInfos must be indexed by ONNXTensorElementDataType");
+
+static const std::unordered_map<std::string, ONNXTensorElementDataType>
+    stringToDataTypeMap = {
+        {"float32", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+        {"uint8", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8},
+        {"int8", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8},
+        {"uint16", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16},
+        {"int16", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16},
+        {"int32", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32},
+        {"int64", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64},
+        {"string", ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING},
+        {"bool", ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL},
+        {"float16", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16},
+        {"float64", ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE},
+        {"uint32", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32},
+        {"uint64", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64},
 };
 
+inline const DataTypeInfo *getDataTypeInfo(ONNXTensorElementDataType type) {
+  auto index = static_cast<size_t>(type);
+  if (index < dataTypeCount && dataTypeInfos[index].name != nullptr) {
+    return &dataTypeInfos[index];
+  }
+  return nullptr;
+}
+
 inline size_t getElementSize(ONNXTensorElementDataType dataType) {
-  auto it = elementSizeMap.find(dataType);
-  if (it != elementSizeMap.end()) {
-    return it->second;
+  auto info = getDataTypeInfo(dataType);
+  if (info != nullptr) {
+    return info->elementSize;
   }
   throw std::invalid_argument("Unsupported or unknown tensor data type: " +
                               std::to_string(static_cast<int>(dataType)));
 }
 
-bool TensorUtils::isTensor(Runtime &runtime, const Object &obj) {
-  return obj.hasProperty(runtime, "cpuData") &&
-         obj.hasProperty(runtime, "dims") && obj.hasProperty(runtime, "type");
+JSTensorProperties TensorUtils::readTensor(Runtime &runtime, Env &env,
+                                          const Object &obj) {
+  auto &cache = env.getJsiCache(runtime);
+  return {obj.getProperty(runtime, cache.cpuData),
+          obj.getProperty(runtime, cache.dims),
+          obj.getProperty(runtime, cache.type)};
 }
 
-inline Object getTypedArrayConstructor(Runtime &runtime,
-                                       const ONNXTensorElementDataType type) {
-  auto it = dataTypeToTypedArrayMap.find(type);
-  if (it != dataTypeToTypedArrayMap.end()) {
-    auto prop = runtime.global().getProperty(runtime, it->second);
-    if (prop.isObject()) {
-      return prop.asObject(runtime);
-    } else {
+inline const Function &getTypedArrayConstructor(
+    Runtime &runtime, JsiCache &cache, const ONNXTensorElementDataType type) {
+  auto info = getDataTypeInfo(type);
+  if (info == nullptr) {
+    throw JSError(runtime,
+                  "Unsupported tensor data type for TypedArray creation: " +
+                      std::to_string(static_cast<int>(type)));
+  }
+  auto &ctors = cache.typedArrayConstructors;
+  if (ctors.empty()) {
+    ctors.resize(dataTypeCount);
+  }
+  auto &ctor = ctors[type];
+  if (!ctor) {
+    auto prop = runtime.global().getProperty(runtime, info->typedArray);
+    if (!prop.isObject() || !prop.asObject(runtime).isFunction(runtime)) {
       throw JSError(runtime, "TypedArray constructor not found: " +
-                                 std::string(it->second));
+                                 std::string(info->typedArray));
     }
+    ctor = std::make_unique<Function>(
+        prop.asObject(runtime).asFunction(runtime));
+  }
+  return *ctor;
+}
+
+inline const String &getCachedTypeName(Runtime &runtime, JsiCache &cache,
+                                       const ONNXTensorElementDataType type) {
+  auto &names = cache.typeNames;
+  if (names.empty()) {
+    names.resize(dataTypeCount);
   }
-  throw JSError(runtime,
-                "Unsupported tensor data type for TypedArray creation: " +
-                    std::to_string(static_cast<int>(type)));
+  auto &name = names[type];
+  if (!name) {
+    name = std::make_unique<String>(
+        String::createFromAscii(runtime, getDataTypeInfo(type)->name));
+  }
+  return *name;
 }
 
+// Hands an ORT-allocated tensor buffer to JS without copying. The OrtValue
+// is shared with the buffer and released once the ArrayBuffer is collected.
+class OrtValueBuffer : public MutableBuffer {
+public:
+  OrtValueBuffer(std::shared_ptr<Ort::Value> value, size_t size)
+      : value_(std::move(value)), size_(size),
+        data_(static_cast<uint8_t *>(value_->GetTensorMutableRawData())) {}
+
+  size_t size() const override { return size_; }
+  uint8_t *data() override { return data_; }
+
+private:
+  std::shared_ptr<Ort::Value> value_;
+  size_t size_;
+  uint8_t *data_;
+};
+
 size_t getElementCount(const std::vector<int64_t> &shape) {
   size_t count = 1;
   for (auto dim : shape) {
@@ -98,20 +144,10 @@ size_t getElementCount(const std::vector<int64_t> &shape) {
   return count;
 }
 
-Ort::Value
-TensorUtils::createOrtValueFromJSTensor(Runtime &runtime,
-                                        const Object &tensorObj,
-                                        const Ort::MemoryInfo &memoryInfo) {
-  if (!isTensor(runtime, tensorObj)) {
-    throw JSError(
-        runtime,
-        "Invalid tensor object: missing cpuData, dims, or type properties");
-  }
-
-  auto dataProperty = tensorObj.getProperty(runtime, "cpuData");
-  auto dimsProperty = tensorObj.getProperty(runtime, "dims");
-  auto typeProperty = tensorObj.getProperty(runtime, "type");
-
+static void getTypeAndShape(Runtime &runtime, const Value &typeProperty,
+                            const Value &dimsProperty,
+                            ONNXTensorElementDataType &type,
+                            std::vector<int64_t> &shape) {
   if (!dimsProperty.isObject() ||
       !dimsProperty.asObject(runtime).isArray(runtime)) {
     throw JSError(runtime, "Tensor dims must be array");
@@ -121,20 +157,98 @@ TensorUtils::createOrtValueFromJSTensor(Runtime &runtime,
     throw JSError(runtime, "Tensor type must be string");
   }
 
-  ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
   auto typeStr = typeProperty.asString(runtime).utf8(runtime);
-  for (auto it = dataTypeToStringMap.begin(); it != dataTypeToStringMap.end();
-       ++it) {
-    if (it->second == typeStr) {
-      type = it->first;
-      break;
+  auto it = stringToDataTypeMap.find(typeStr);
+  if (it == stringToDataTypeMap.end()) {
+    throw JSError(runtime, "Unsupported tensor data type: " + typeStr);
+  }
+  type = it->second;
+
+  shape.clear();
+  auto dimsArray = dimsProperty.asObject(runtime).asArray(runtime);
+  auto rank = dimsArray.size(runtime);
+  shape.reserve(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    auto dim = dimsArray.getValueAtIndex(runtime, i);
+    if (dim.isNumber()) {
+      shape.push_back(static_cast<int64_t>(dim.asNumber()));
     }
   }
-  if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
-    throw JSError(runtime, "Unsupported tensor data type: " + typeStr);
+}
+
+void TensorUtils::getTensorTypeAndShape(Runtime &runtime, Env &env,
+                                        const Object &tensorObj,
+                                        ONNXTensorElementDataType &type,
+                                        std::vector<int64_t> &shape) {
+  auto &cache = env.getJsiCache(runtime);
+  getTypeAndShape(runtime, tensorObj.getProperty(runtime, cache.type),
+                  tensorObj.getProperty(runtime, cache.dims), type, shape);
+}
+
+void TensorUtils::getTensorTypeAndShape(Runtime &runtime,
+                                        const JSTensorProperties &tensor,
+                                        ONNXTensorElementDataType &type,
+                                        std::vector<int64_t> &shape) {
+  getTypeAndShape(runtime, tensor.type, tensor.dims, type, shape);
+}
+
+// Same as getTypedArrayData in JsiUtils, using the cached property names.
+static uint8_t *getTypedArrayData(Runtime &runtime, JsiCache &cache,
+                                  const Object &typedArray,
+                                  size_t &byteLength) {
+  auto bufferProperty = typedArray.getProperty(runtime, cache.buffer);
+  if (!bufferProperty.isObject() ||
+      !bufferProperty.asObject(runtime).isArrayBuffer(runtime)) {
+    throw JSError(runtime, "Tensor data must be a TypedArray");
+  }
+  auto buffer = bufferProperty.asObject(runtime).getArrayBuffer(runtime);
+  size_t bufferSize = buffer.size(runtime);
+  size_t byteOffset = 0;
+  byteLength = bufferSize;
+  auto offsetValue = typedArray.getProperty(runtime, cache.byteOffset);
+  if (offsetValue.isNumber()) {
+    byteOffset = static_cast<size_t>(offsetValue.asNumber());
+  }
+  auto lengthValue = typedArray.getProperty(runtime, cache.byteLength);
+  if (lengthValue.isNumber()) {
+    byteLength = static_cast<size_t>(lengthValue.asNumber());
+  }
+  if (byteOffset > bufferSize || byteLength > bufferSize - byteOffset) {
+    throw JSError(runtime, "TypedArray view is out of ArrayBuffer bounds");
   }
+  return buffer.data(runtime) + byteOffset;
+}
+
+Ort::Value
+TensorUtils::createOrtValueFromJSTensor(Runtime &runtime, Env &env,
+                                        const Object &tensorObj,
+                                        const Ort::MemoryInfo &memoryInfo) {
+  return createOrtValueFromJSTensor(
+      runtime, env, readTensor(runtime, env, tensorObj), memoryInfo);
+}
+
+Ort::Value
+TensorUtils::createOrtValueFromJSTensor(Runtime &runtime, Env &env,
+                                        const JSTensorProperties &tensor,
+                                        const Ort::MemoryInfo &memoryInfo) {
+  TraceSpan span(env.getTrace(), "createOrtValueFromJSTensor");
+  if (!tensor.isTensor()) {
+    throw JSError(
+        runtime,
+        "Invalid tensor object: missing cpuData, dims, or type properties");
+  }
+  auto &cache = env.getJsiCache(runtime);
+  const auto &dataProperty = tensor.cpuData;
+
+  ONNXTensorElementDataType type;
+  std::vector<int64_t> shape;
+  getTypeAndShape(runtime, tensor.type, tensor.dims, type, shape);
 
+  if (!dataProperty.isObject()) {
+    throw JSError(runtime, "Tensor data must be a TypedArray");
+  }
   void *data = nullptr;
+  size_t dataByteLength = 0;
   auto dataObj = dataProperty.asObject(runtime);
 
   if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
@@ -150,45 +264,207 @@ TensorUtils::createOrtValueFromJSTensor(Runtime &runtime,
           strdup(item.toString(runtime).utf8(runtime).c_str());
     }
   } else {
-    if (!isTypedArray(runtime, dataObj)) {
-      throw JSError(runtime, "Tensor data must be a TypedArray");
-    }
-    auto buffer = dataObj.getProperty(runtime, "buffer")
-                      .asObject(runtime)
-                      .getArrayBuffer(runtime);
-    data = buffer.data(runtime);
+    data = getTypedArrayData(runtime, cache, dataObj, dataByteLength);
   }
 
-  std::vector<int64_t> shape;
-  auto dimsArray = dimsProperty.asObject(runtime).asArray(runtime);
-  for (size_t i = 0; i < dimsArray.size(runtime); ++i) {
-    auto dim = dimsArray.getValueAtIndex(runtime, i);
-    if (dim.isNumber()) {
-      shape.push_back(static_cast<int64_t>(dim.asNumber()));
-    }
+  size_t byteLength = getElementCount(shape) * getElementSize(type);
+  if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING &&
+      byteLength > dataByteLength) {
+    throw JSError(runtime, "Tensor data is smaller than its dims require");
   }
 
-  return Ort::Value::CreateTensor(memoryInfo, data,
-                                  getElementCount(shape) * getElementSize(type),
-                                  shape.data(), shape.size(), type);
+  return Ort::Value::CreateTensor(memoryInfo, data, byteLength, shape.data(),
+                                  shape.size(), type);
 }
 
-Object
-TensorUtils::createJSTensorFromOrtValue(Runtime &runtime, Ort::Value &ortValue,
-                                        const Object &tensorConstructor) {
-  auto typeInfo = ortValue.GetTensorTypeAndShapeInfo();
-  auto shape = typeInfo.GetShape();
-  auto elementType = typeInfo.GetElementType();
+Value TensorUtils::getTypeName(Runtime &runtime, Env &env,
+                               ONNXTensorElementDataType type) {
+  if (getDataTypeInfo(type) == nullptr) {
+    throw JSError(runtime, "Unsupported tensor data type: " +
+                               std::to_string(static_cast<int>(type)));
+  }
+  return Value(runtime,
+               getCachedTypeName(runtime, env.getJsiCache(runtime), type));
+}
 
-  std::string typeStr;
-  auto it = dataTypeToStringMap.find(elementType);
-  if (it != dataTypeToStringMap.end()) {
-    typeStr = it->second;
-  } else {
+Value TensorUtils::createTypedArrayFromOrtValue(
+    Runtime &runtime, Env &env, std::shared_ptr<Ort::Value> ortValue) {
+  auto typeInfo = ortValue->GetTensorTypeAndShapeInfo();
+  auto elementType = typeInfo.GetElementType();
+  auto info = getDataTypeInfo(elementType);
+  if (info == nullptr || elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
     throw JSError(runtime,
                   "Unsupported tensor data type for TypedArray creation: " +
                       std::to_string(static_cast<int>(elementType)));
   }
+  size_t dataSize = typeInfo.GetElementCount() * info->elementSize;
+  auto arrayBuffer = ArrayBuffer(
+      runtime, std::make_shared<OrtValueBuffer>(std::move(ortValue), dataSize));
+  return getTypedArrayConstructor(runtime, env.getJsiCache(runtime),
+                                  elementType)
+      .callAsConstructor(runtime, arrayBuffer);
+}
+
+Ort::Value TensorUtils::createOrtValueView(const Ort::Value &source,
+                                           const Ort::MemoryInfo &memoryInfo) {
+  auto typeInfo = source.GetTensorTypeAndShapeInfo();
+  auto elementType = typeInfo.GetElementType();
+  auto shape = typeInfo.GetShape();
+  if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+    throw std::invalid_argument("String tensors cannot be shared as a view");
+  }
+  size_t byteLength =
+      typeInfo.GetElementCount() * getElementSize(elementType);
+  return Ort::Value::CreateTensor(
+      memoryInfo, const_cast<void *>(source.GetTensorRawData()), byteLength,
+      shape.data(), shape.size(), elementType);
+}
+
+size_t TensorUtils::getByteLength(const Ort::Value &value) {
+  auto typeInfo = value.GetTensorTypeAndShapeInfo();
+  auto elementType = typeInfo.GetElementType();
+  if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+    return value.GetStringTensorDataLength();
+  }
+  return typeInfo.GetElementCount() * getElementSize(elementType);
+}
+
+Ort::Value TensorUtils::createZeroTensor(const std::vector<int64_t> &shape,
+                                         ONNXTensorElementDataType type,
+                                         OrtAllocator *allocator) {
+  auto value =
+      Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+  // String tensors start out as empty strings.
+  if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+    std::memset(value.GetTensorMutableRawData(), 0,
+                getElementCount(shape) * getElementSize(type));
+  }
+  return value;
+}
+
+Ort::Value TensorUtils::cloneTensor(const Ort::Value &source,
+                                    OrtAllocator *allocator) {
+  auto typeInfo = source.GetTensorTypeAndShapeInfo();
+  auto elementType = typeInfo.GetElementType();
+  auto shape = typeInfo.GetShape();
+  if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+    throw std::invalid_argument("String tensors cannot be copied");
+  }
+  auto result = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(),
+                                         elementType);
+  std::memcpy(result.GetTensorMutableRawData(), source.GetTensorRawData(),
+              typeInfo.GetElementCount() * getElementSize(elementType));
+  return result;
+}
+
+// Number of elements before and from `axis` on, for copying slabs along it.
+static void splitShapeAt(const std::vector<int64_t> &shape, size_t axis,
+                         size_t &outer, size_t &inner) {
+  outer = 1;
+  inner = 1;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    (i < axis ? outer : inner) *= static_cast<size_t>(shape[i]);
+  }
+}
+
+Ort::Value
+TensorUtils::concatTensors(const std::vector<const Ort::Value *> &values,
+                           size_t axis, OrtAllocator *allocator) {
+  auto firstInfo = values[0]->GetTensorTypeAndShapeInfo();
+  auto type = firstInfo.GetElementType();
+  auto shape = firstInfo.GetShape();
+  if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+    throw std::invalid_argument("String tensors cannot be concatenated");
+  }
+  if (axis >= shape.size()) {
+    throw std::invalid_argument("Concat axis is out of range");
+  }
+  size_t elementSize = getElementSize(type);
+  int64_t total = 0;
+  for (auto value : values) {
+    total += value->GetTensorTypeAndShapeInfo().GetShape()[axis];
+  }
+  size_t outer, inner;
+  splitShapeAt(shape, axis, outer, inner);
+  shape[axis] = total;
+  auto result =
+      Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+  auto dst = static_cast<uint8_t *>(result.GetTensorMutableRawData());
+  // Each value contributes one contiguous slab per outer index.
+  for (size_t o = 0; o < outer; ++o) {
+    for (auto value : values) {
+      auto valueShape = value->GetTensorTypeAndShapeInfo().GetShape();
+      size_t valueOuter, valueInner;
+      splitShapeAt(valueShape, axis, valueOuter, valueInner);
+      size_t bytes = valueInner * elementSize;
+      auto src = static_cast<const uint8_t *>(value->GetTensorRawData());
+      std::memcpy(dst, src + o * bytes, bytes);
+      dst += bytes;
+    }
+  }
+  return result;
+}
+
+std::vector<Ort::Value>
+TensorUtils::splitTensor(const Ort::Value &value, size_t axis,
+                         const std::vector<int64_t> &sizes,
+                         OrtAllocator *allocator) {
+  auto info = value.GetTensorTypeAndShapeInfo();
+  auto type = info.GetElementType();
+  auto shape = info.GetShape();
+  if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+    throw std::invalid_argument("String tensors cannot be split");
+  }
+  int64_t total = 0;
+  for (auto size : sizes) {
+    total += size;
+  }
+  if (axis >= shape.size() || shape[axis] != total) {
+    throw std::invalid_argument("Tensor does not have the split dimension");
+  }
+  size_t elementSize = getElementSize(type);
+  size_t outer, inner;
+  splitShapeAt(shape, axis, outer, inner);
+  // Bytes of one step along axis.
+  size_t rowBytes = total > 0 ? inner / total * elementSize : 0;
+  auto src = static_cast<const uint8_t *>(value.GetTensorRawData());
+
+  std::vector<Ort::Value> results;
+  results.reserve(sizes.size());
+  size_t rowOffset = 0;
+  for (auto size : sizes) {
+    shape[axis] = size;
+    auto part =
+        Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+    auto dst = static_cast<uint8_t *>(part.GetTensorMutableRawData());
+    size_t bytes = size * rowBytes;
+    for (size_t o = 0; o < outer; ++o) {
+      std::memcpy(dst + o * bytes,
+                  src + o * total * rowBytes + rowOffset * rowBytes, bytes);
+    }
+    rowOffset += size;
+    results.push_back(std::move(part));
+  }
+  return results;
+}
+
+Object TensorUtils::createJSTensorFromOrtValue(
+    Runtime &runtime, Env &env, Ort::Value &ortValue,
+    const Object &tensorConstructor) {
+  return createJSTensorFromOrtValue(
+      runtime, env, std::make_shared<Ort::Value>(std::move(ortValue)),
+      tensorConstructor);
+}
+
+Object TensorUtils::createJSTensorFromOrtValue(
+    Runtime &runtime, Env &env, std::shared_ptr<Ort::Value> ortValue,
+    const Object &tensorConstructor) {
+  TraceSpan span(env.getTrace(), "createJSTensorFromOrtValue");
+  auto typeInfo = ortValue->GetTensorTypeAndShapeInfo();
+  auto shape = typeInfo.GetShape();
+  auto elementType = typeInfo.GetElementType();
+
+  auto typeName = getTypeName(runtime, env, elementType);
 
   auto dimsArray = Array(runtime, shape.size());
   for (size_t j = 0; j < shape.size(); ++j) {
@@ -196,26 +472,12 @@ TensorUtils::createJSTensorFromOrtValue(Runtime &runtime, Ort::Value &ortValue,
   }
 
   if (elementType != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
-    void *rawData = ortValue.GetTensorMutableRawData();
-    size_t elementCount =
-        ortValue.GetTensorTypeAndShapeInfo().GetElementCount();
-    size_t elementSize = getElementSize(elementType);
-    size_t dataSize = elementCount * elementSize;
-
-    auto typedArrayCtor = getTypedArrayConstructor(runtime, elementType);
     auto typedArrayInstance =
-        typedArrayCtor.asFunction(runtime).callAsConstructor(
-            runtime, static_cast<double>(elementCount));
-
-    auto buffer = typedArrayInstance.asObject(runtime)
-                      .getProperty(runtime, "buffer")
-                      .asObject(runtime)
-                      .getArrayBuffer(runtime);
-    memcpy(buffer.data(runtime), rawData, dataSize);
+        createTypedArrayFromOrtValue(runtime, env, std::move(ortValue));
 
     auto tensorInstance =
         tensorConstructor.asFunction(runtime).callAsConstructor(
-            runtime, typeStr, typedArrayInstance, dimsArray);
+            runtime, typeName, typedArrayInstance, dimsArray);
 
     return tensorInstance.asObject(runtime);
   } else {
@@ -227,7 +489,7 @@ TensorUtils::createJSTensorFromOrtValue(Runtime &runtime, Ort::Value &ortValue,
 
     auto tensorInstance =
         tensorConstructor.asFunction(runtime).callAsConstructor(
-            runtime, typeStr, strArray, dimsArray);
+            runtime, typeName, strArray, dimsArray);
 
     return tensorInstance.asObject(runtime);
   }
@@ -1,26 +1,103 @@
 #pragma once
 
+#include "Env.h"
 #include <jsi/jsi.h>
+#include <memory>
 #include <onnxruntime_cxx_api.h>
 #include <string>
 #include <vector>
 
 namespace onnxruntimereactnativejsi {
 
+// The properties of a JS tensor, each read once. Missing ones are
+// undefined.
+struct JSTensorProperties {
+  facebook::jsi::Value cpuData;
+  facebook::jsi::Value dims;
+  facebook::jsi::Value type;
+
+  inline bool isTensor() const {
+    return !cpuData.isUndefined() && !dims.isUndefined() &&
+           !type.isUndefined();
+  }
+};
+
 class TensorUtils {
 public:
+  static JSTensorProperties readTensor(facebook::jsi::Runtime &runtime,
+                                       Env &env,
+                                       const facebook::jsi::Object &obj);
+
   static Ort::Value
-  createOrtValueFromJSTensor(facebook::jsi::Runtime &runtime,
+  createOrtValueFromJSTensor(facebook::jsi::Runtime &runtime, Env &env,
                              const facebook::jsi::Object &tensorObj,
                              const Ort::MemoryInfo &memoryInfo);
 
+  static Ort::Value
+  createOrtValueFromJSTensor(facebook::jsi::Runtime &runtime, Env &env,
+                             const JSTensorProperties &tensor,
+                             const Ort::MemoryInfo &memoryInfo);
+
+  // ortValue is moved into the returned JS tensor, whose data aliases the
+  // ORT allocation; ortValue is left empty.
   static facebook::jsi::Object
-  createJSTensorFromOrtValue(facebook::jsi::Runtime &runtime,
+  createJSTensorFromOrtValue(facebook::jsi::Runtime &runtime, Env &env,
                              Ort::Value &ortValue,
                              const facebook::jsi::Object &tensorConstructor);
 
-  static bool isTensor(facebook::jsi::Runtime &runtime,
-                       const facebook::jsi::Object &obj);
+  static facebook::jsi::Object
+  createJSTensorFromOrtValue(facebook::jsi::Runtime &runtime, Env &env,
+                             std::shared_ptr<Ort::Value> ortValue,
+                             const facebook::jsi::Object &tensorConstructor);
+
+  // TypedArray over the tensor's memory, without copying. The array keeps
+  // ortValue alive.
+  static facebook::jsi::Value
+  createTypedArrayFromOrtValue(facebook::jsi::Runtime &runtime, Env &env,
+                               std::shared_ptr<Ort::Value> ortValue);
+
+  // Tensor sharing the memory of a non-string source tensor. The source must
+  // outlive the view.
+  static Ort::Value createOrtValueView(const Ort::Value &source,
+                                       const Ort::MemoryInfo &memoryInfo);
+
+  // Tensor of the given shape filled with zeros, or empty strings.
+  static Ort::Value createZeroTensor(const std::vector<int64_t> &shape,
+                                     ONNXTensorElementDataType type,
+                                     OrtAllocator *allocator);
+
+  // Copy of a non-string tensor in memory from allocator.
+  static Ort::Value cloneTensor(const Ort::Value &source,
+                                OrtAllocator *allocator);
+
+  // Concatenates non-string tensors of equal type along axis. All other
+  // dimensions must match.
+  static Ort::Value concatTensors(const std::vector<const Ort::Value *> &values,
+                                  size_t axis, OrtAllocator *allocator);
+
+  // Inverse of concatTensors: slices value along axis into parts of the
+  // given sizes.
+  static std::vector<Ort::Value> splitTensor(const Ort::Value &value,
+                                             size_t axis,
+                                             const std::vector<int64_t> &sizes,
+                                             OrtAllocator *allocator);
+
+  // Bytes of tensor data; for string tensors, of the strings' contents.
+  static size_t getByteLength(const Ort::Value &value);
+
+  static facebook::jsi::Value getTypeName(facebook::jsi::Runtime &runtime,
+                                          Env &env,
+                                          ONNXTensorElementDataType type);
+
+  static void getTensorTypeAndShape(facebook::jsi::Runtime &runtime, Env &env,
+                                    const facebook::jsi::Object &tensorObj,
+                                    ONNXTensorElementDataType &type,
+                                    std::vector<int64_t> &shape);
+
+  static void getTensorTypeAndShape(facebook::jsi::Runtime &runtime,
+                                    const JSTensorProperties &tensor,
+                                    ONNXTensorElementDataType &type,
+                                    std::vector<int64_t> &shape);
 };
 
 } // namespace onnxruntimereactnativejsi
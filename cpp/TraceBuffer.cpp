@@ -0,0 +1,205 @@
+#include "TraceBuffer.h"
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+#if defined(__APPLE__)
+#include <pthread.h>
+#else
+#include <sys/syscall.h>
+#endif
+
+namespace onnxruntimereactnativejsi {
+
+namespace {
+
+struct Span {
+  const char *name;
+  int64_t startNs;
+  int64_t endNs;
+  uint64_t threadId;
+  uint64_t requestId;
+  bool async;
+};
+
+int64_t toNs(TraceBuffer::Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+// Steady clock to high_resolution_clock, which are the same clock on the
+// libc++ platforms this runs on.
+int64_t clockOffsetNs() {
+  auto steady = TraceBuffer::Clock::now();
+  auto highResolution = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             highResolution.time_since_epoch())
+             .count() -
+         toNs(steady);
+}
+
+// The body of a JSON array, without its brackets.
+std::string arrayBody(const std::string &json) {
+  auto open = json.find('[');
+  auto close = json.rfind(']');
+  if (open == std::string::npos || close == std::string::npos ||
+      close <= open) {
+    return "";
+  }
+  auto body = json.substr(open + 1, close - open - 1);
+  auto last = body.find_last_not_of(" \t\r\n,");
+  return last == std::string::npos ? "" : body.substr(0, last + 1);
+}
+
+// Microseconds with nanosecond digits, which a double of the full
+// timestamp would not keep.
+void writeUs(std::ostream &out, int64_t ns) {
+  if (ns < 0) {
+    out << '-';
+    ns = -ns;
+  }
+  auto fraction = std::to_string(ns % 1000);
+  out << ns / 1000 << '.' << std::string(3 - fraction.size(), '0')
+      << fraction;
+}
+
+} // namespace
+
+void TraceBuffer::start(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!slots_) {
+    capacity_ = std::max<size_t>(capacity, 1);
+    slots_.reset(new Slot[capacity_]);
+  }
+  jsThreadId_ = currentThreadId();
+  enabled_.store(true, std::memory_order_release);
+}
+
+void TraceBuffer::stop() { enabled_.store(false, std::memory_order_release); }
+
+void TraceBuffer::clear() {
+  first_.store(next_.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+}
+
+void TraceBuffer::record(const char *name, Clock::time_point start,
+                         Clock::time_point end, uint64_t requestId,
+                         Kind kind) {
+  if (!enabled()) {
+    return;
+  }
+  auto index = next_.fetch_add(1, std::memory_order_relaxed);
+  auto &slot = slots_[index % capacity_];
+  // A seqlock per slot: readers skip slots whose sequence changes while
+  // they copy them.
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.startNs.store(toNs(start), std::memory_order_relaxed);
+  slot.endNs.store(toNs(end), std::memory_order_relaxed);
+  slot.threadId.store(currentThreadId(), std::memory_order_relaxed);
+  slot.requestId.store(requestId, std::memory_order_relaxed);
+  slot.async.store(kind == Kind::Async, std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::string TraceBuffer::toJson(const std::string &ortProfile,
+                                int64_t ortStartNs) const {
+  std::vector<Span> spans;
+  auto next = next_.load(std::memory_order_acquire);
+  if (slots_ && next > 0) {
+    auto from = std::max(first_.load(std::memory_order_relaxed),
+                         next > capacity_ ? next - capacity_ : 0);
+    for (auto index = from; index < next; ++index) {
+      const auto &slot = slots_[index % capacity_];
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      Span span{slot.name.load(std::memory_order_relaxed),
+                slot.startNs.load(std::memory_order_relaxed),
+                slot.endNs.load(std::memory_order_relaxed),
+                slot.threadId.load(std::memory_order_relaxed),
+                slot.requestId.load(std::memory_order_relaxed),
+                slot.async.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence != index + 1 ||
+          slot.sequence.load(std::memory_order_relaxed) != sequence) {
+        continue;
+      }
+      spans.push_back(span);
+    }
+  }
+  std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+    return a.startNs < b.startNs;
+  });
+
+  auto pid = static_cast<long>(getpid());
+  auto offsetNs = clockOffsetNs() - ortStartNs;
+  std::ostringstream json;
+  json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto begin = [&]() -> std::ostringstream & {
+    json << (first ? "" : ",") << "\n{";
+    first = false;
+    return json;
+  };
+
+  std::set<uint64_t> threads;
+  for (const auto &span : spans) {
+    auto startNs = span.startNs + offsetNs;
+    auto endNs = span.endNs + offsetNs;
+    if (!ortProfile.empty() && startNs < 0) {
+      continue;
+    }
+    threads.insert(span.threadId);
+    auto common = [&](const char *phase, int64_t ns) {
+      begin() << "\"cat\":\"binding\",\"name\":\"" << span.name
+              << "\",\"ph\":\"" << phase << "\",\"pid\":" << pid
+              << ",\"tid\":" << span.threadId << ",\"ts\":";
+      writeUs(json, ns);
+    };
+    if (span.async) {
+      common("b", startNs);
+      json << ",\"id\":" << span.requestId << "}";
+      common("e", endNs);
+      json << ",\"id\":" << span.requestId << "}";
+    } else {
+      common("X", startNs);
+      json << ",\"dur\":";
+      writeUs(json, endNs - startNs);
+      json << ",\"args\":{\"request\":" << span.requestId << "}}";
+    }
+  }
+  for (auto thread : threads) {
+    begin() << "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << thread << ",\"args\":{\"name\":\""
+            << (thread == jsThreadId_ ? "JS" : "Worker") << "\"}}";
+  }
+
+  auto ortEvents = arrayBody(ortProfile);
+  if (!ortEvents.empty()) {
+    json << (first ? "" : ",") << ortEvents;
+  }
+  json << "\n]}";
+  return json.str();
+}
+
+uint64_t TraceBuffer::newRequestId() {
+  static std::atomic<uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t TraceBuffer::currentThreadId() {
+  thread_local uint64_t id = []() -> uint64_t {
+#if defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return tid;
+#else
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#endif
+  }();
+  return id;
+}
+
+} // namespace onnxruntimereactnativejsi
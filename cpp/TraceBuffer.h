@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace onnxruntimereactnativejsi {
+
+// Fixed-size ring of timed spans recorded by the binding itself (promise
+// setup, queueing, thread hops, tensor conversion), which ORT's profiler
+// cannot see. Recording is lock-free and costs one atomic load while
+// tracing is off; once full, the oldest spans are overwritten.
+class TraceBuffer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Spans on one thread must nest. Async spans may overlap anything, e.g.
+  // time spent waiting in a queue, and are exported per request instead.
+  enum class Kind { Complete, Async };
+
+  // The first call sizes the buffer; later calls only resume recording.
+  void start(size_t capacity);
+  void stop();
+  // Drops the spans recorded so far.
+  void clear();
+
+  inline bool enabled() const {
+    return enabled_.load(std::memory_order_acquire);
+  }
+
+  // name must be a string literal, or outlive the buffer.
+  void record(const char *name, Clock::time_point start,
+              Clock::time_point end, uint64_t requestId,
+              Kind kind = Kind::Complete);
+
+  // Chrome trace event JSON, loadable in Perfetto or chrome://tracing.
+  // Timestamps are microseconds of the high_resolution_clock that ORT stamps
+  // its profile with. If ortProfile is set, its events, which are relative
+  // to ortStartNs, are merged in, and spans before that start are dropped.
+  std::string toJson(const std::string &ortProfile = "",
+                     int64_t ortStartNs = 0) const;
+
+  // Ties the spans of one async call together.
+  static uint64_t newRequestId();
+  static uint64_t currentThreadId();
+
+private:
+  struct Slot {
+    // Index + 1 of the span in the slot, 0 while it is being written.
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<int64_t> startNs{0};
+    std::atomic<int64_t> endNs{0};
+    std::atomic<uint64_t> threadId{0};
+    std::atomic<uint64_t> requestId{0};
+    std::atomic<bool> async{false};
+  };
+
+  std::mutex mutex_;
+  // Set once, before enabled_ is first raised.
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_ = 0;
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> next_{0};
+  std::atomic<uint64_t> first_{0};
+  uint64_t jsThreadId_ = 0;
+};
+
+// Records the enclosing scope as a span if tracing was on when it began.
+class TraceSpan {
+public:
+  TraceSpan(TraceBuffer &trace, const char *name, uint64_t requestId = 0)
+      : trace_(trace.enabled() ? &trace : nullptr), name_(name),
+        requestId_(requestId) {
+    if (trace_) {
+      start_ = TraceBuffer::Clock::now();
+    }
+  }
+
+  ~TraceSpan() {
+    if (trace_) {
+      trace_->record(name_, start_, TraceBuffer::Clock::now(), requestId_);
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  TraceBuffer *trace_;
+  const char *name_;
+  uint64_t requestId_;
+  TraceBuffer::Clock::time_point start_;
+};
+
+} // namespace onnxruntimereactnativejsi
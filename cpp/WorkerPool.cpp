@@ -0,0 +1,201 @@
+#include "WorkerPool.h"
+#include "log.h"
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+
+namespace onnxruntimereactnativejsi {
+
+WorkerPool::WorkerPool(size_t size) : state_(std::make_shared<State>()) {
+  state_->startTime = std::chrono::steady_clock::now();
+  size = std::max<size_t>(size, 1);
+  threads_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    threads_.emplace_back(&WorkerPool::workerLoop, state_);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stop = true;
+  }
+  state_->cv.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+size_t WorkerPool::defaultSize() {
+  size_t cores = std::thread::hardware_concurrency();
+  return std::clamp<size_t>(cores / 2, 1, 4);
+}
+
+void WorkerPool::submit(Task &&task, Priority priority) {
+  state_->pending++;
+  state_->submitted++;
+  auto state = state_;
+  enqueue(
+      state, [state, task = std::move(task)]() { run(state, task); },
+      priority);
+}
+
+void WorkerPool::submit(const std::shared_ptr<SerialQueue> &queue,
+                        Task &&task, Priority priority) {
+  if (!queue) {
+    submit(std::move(task), priority);
+    return;
+  }
+  state_->pending++;
+  state_->submitted++;
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex_);
+    queue->tasks_[static_cast<size_t>(priority)].push_back(std::move(task));
+    // A running queue reschedules itself when done. Otherwise make sure a
+    // ticket at least as urgent as this task is waiting in the pool queue.
+    if (!queue->running_ &&
+        static_cast<size_t>(priority) < queue->scheduledPriority_) {
+      queue->scheduledPriority_ = static_cast<size_t>(priority);
+      schedule = true;
+    }
+  }
+  if (schedule) {
+    scheduleDrain(state_, queue, priority);
+  }
+}
+
+bool WorkerPool::SerialQueue::empty() const {
+  for (const auto &tasks : tasks_) {
+    if (!tasks.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+WorkerPool::Priority WorkerPool::SerialQueue::topPriority() const {
+  for (size_t i = 0; i < kPriorityCount; ++i) {
+    if (!tasks_[i].empty()) {
+      return static_cast<Priority>(i);
+    }
+  }
+  return Priority::Low;
+}
+
+WorkerPool::Stats WorkerPool::getStats() const {
+  Stats stats;
+  stats.size = threads_.size();
+  stats.queueDepth = state_->pending.load();
+  stats.activeWorkers = state_->active.load();
+  stats.submitted = state_->submitted.load();
+  stats.completed = state_->completed.load();
+  auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - state_->startTime)
+                       .count();
+  stats.utilization =
+      elapsedNs > 0 ? static_cast<double>(state_->busyNs.load()) /
+                          (static_cast<double>(elapsedNs) * stats.size)
+                    : 0.0;
+  return stats;
+}
+
+void WorkerPool::enqueue(const std::shared_ptr<State> &state, Task &&task,
+                         Priority priority) {
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->tasks[static_cast<size_t>(priority)].push_back(std::move(task));
+  }
+  state->cv.notify_one();
+}
+
+void WorkerPool::scheduleDrain(const std::shared_ptr<State> &state,
+                               const std::shared_ptr<SerialQueue> &queue,
+                               Priority priority) {
+  enqueue(
+      state, [state, queue]() { drain(state, queue); }, priority);
+}
+
+// Runs the most urgent task of a serial queue, then puts the queue back at
+// the tail of the pool queue if more work is waiting so other sessions are
+// not starved. A queue may hold several tickets after a more urgent task
+// arrived; tickets that find it running or empty do nothing.
+void WorkerPool::drain(const std::shared_ptr<State> &state,
+                       const std::shared_ptr<SerialQueue> &queue) {
+  Task task;
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex_);
+    if (queue->running_ || queue->empty()) {
+      return;
+    }
+    auto &tasks = queue->tasks_[static_cast<size_t>(queue->topPriority())];
+    task = std::move(tasks.front());
+    tasks.pop_front();
+    queue->running_ = true;
+    queue->scheduledPriority_ = kPriorityCount;
+  }
+  run(state, task);
+  bool more = false;
+  Priority next = Priority::Low;
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex_);
+    queue->running_ = false;
+    more = !queue->empty();
+    if (more) {
+      next = queue->topPriority();
+      queue->scheduledPriority_ = static_cast<size_t>(next);
+    }
+  }
+  if (more) {
+    scheduleDrain(state, queue, next);
+  }
+}
+
+void WorkerPool::run(const std::shared_ptr<State> &state, const Task &task) {
+  state->pending--;
+  try {
+    task();
+  } catch (const std::exception &e) {
+    LOGE("Uncaught exception in worker task: %s", e.what());
+  } catch (...) {
+    LOGE("Uncaught unknown exception in worker task");
+  }
+  state->completed++;
+}
+
+void WorkerPool::workerLoop(std::shared_ptr<State> state) {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      std::deque<Task> *tasks = nullptr;
+      state->cv.wait(lock, [&state, &tasks] {
+        for (auto &queue : state->tasks) {
+          if (!queue.empty()) {
+            tasks = &queue;
+            return true;
+          }
+        }
+        return state->stop;
+      });
+      if (!tasks) {
+        return;
+      }
+      task = std::move(tasks->front());
+      tasks->pop_front();
+    }
+    state->active++;
+    auto start = std::chrono::steady_clock::now();
+    task();
+    state->busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    state->active--;
+  }
+}
+
+} // namespace onnxruntimereactnativejsi
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace onnxruntimereactnativejsi {
+
+// Fixed-size pool of persistent worker threads shared by every AsyncWorker.
+class WorkerPool {
+public:
+  typedef std::function<void()> Task;
+
+  // Higher classes are always dequeued first, both across the pool and
+  // within a serial queue.
+  enum class Priority { High = 0, Normal = 1, Low = 2 };
+  static constexpr size_t kPriorityCount = 3;
+
+  // FIFO of tasks that never run concurrently with each other, e.g. all the
+  // work queued for one session. Tasks from different queues interleave.
+  class SerialQueue {
+  public:
+    SerialQueue() = default;
+
+  private:
+    friend class WorkerPool;
+
+    bool empty() const;
+    Priority topPriority() const;
+
+    std::mutex mutex_;
+    std::deque<Task> tasks_[kPriorityCount];
+    // Priority of the most urgent drain ticket in the pool queue, or
+    // kPriorityCount when none is pending.
+    size_t scheduledPriority_ = kPriorityCount;
+    bool running_ = false;
+  };
+
+  struct Stats {
+    size_t size;
+    size_t queueDepth;
+    size_t activeWorkers;
+    uint64_t submitted;
+    uint64_t completed;
+    // Busy time across all workers divided by wall time times pool size,
+    // measured since the pool was created.
+    double utilization;
+  };
+
+  explicit WorkerPool(size_t size);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  void submit(Task &&task, Priority priority = Priority::Normal);
+  void submit(const std::shared_ptr<SerialQueue> &queue, Task &&task,
+              Priority priority = Priority::Normal);
+
+  Stats getStats() const;
+
+  // Tasks submitted but not yet started.
+  inline size_t pending() const { return state_->pending.load(); }
+
+  inline size_t size() const { return threads_.size(); }
+
+  static size_t defaultSize();
+
+private:
+  // Shared with the worker threads so that the last Env reference may be
+  // dropped from inside a task without tearing the pool down under it.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Task> tasks[kPriorityCount];
+    bool stop = false;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> active{0};
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> busyNs{0};
+    std::chrono::steady_clock::time_point startTime;
+  };
+
+  static void workerLoop(std::shared_ptr<State> state);
+  static void enqueue(const std::shared_ptr<State> &state, Task &&task,
+                      Priority priority);
+  static void scheduleDrain(const std::shared_ptr<State> &state,
+                            const std::shared_ptr<SerialQueue> &queue,
+                            Priority priority);
+  static void run(const std::shared_ptr<State> &state, const Task &task);
+  static void drain(const std::shared_ptr<State> &state,
+                    const std::shared_ptr<SerialQueue> &queue);
+
+  std::shared_ptr<State> state_;
+  std::vector<std::thread> threads_;
+};
+
+} // namespace onnxruntimereactnativejsi
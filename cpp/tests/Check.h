@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal assertions for the native tests: a failed CHECK is reported and
+// the test keeps going; main() returns TEST_RESULT().
+
+inline int &testFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__,    \
+                   #condition);                                                \
+      ++testFailures();                                                        \
+    }                                                                          \
+  } while (0)
+
+#define TEST_RESULT() (testFailures() == 0 ? 0 : 1)
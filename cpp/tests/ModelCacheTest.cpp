@@ -0,0 +1,148 @@
+#include "Check.h"
+#include "ModelCache.h"
+#include "Sha256.h"
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+class TempDirectory {
+public:
+  TempDirectory() {
+    char name[] = "/tmp/model-cache-XXXXXX";
+    path_ = mkdtemp(name);
+  }
+
+  ~TempDirectory() {
+    std::system(("rm -rf '" + path_ + "'").c_str());
+  }
+
+  const std::string &path() const { return path_; }
+
+private:
+  std::string path_;
+};
+
+void write(const std::string &path, const std::string &contents) {
+  std::ofstream(path) << contents;
+}
+
+// Stands in for ORT writing the optimized model.
+void store(ModelCache &cache) {
+  write(cache.pendingPath(), "optimized");
+  cache.commit();
+}
+
+size_t countEntries(const std::string &directory) {
+  size_t count = 0;
+  DIR *dir = opendir(directory.c_str());
+  while (auto *entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      ++count;
+    }
+  }
+  closedir(dir);
+  return count;
+}
+
+void setModifiedTime(const std::string &path, time_t seconds) {
+  struct timeval times[2] = {{seconds, 0}, {seconds, 0}};
+  utimes(path.c_str(), times);
+}
+
+void testHitAfterCommit() {
+  TempDirectory root;
+  auto model = root.path() + "/model.onnx";
+  write(model, "model");
+  auto cacheDir = root.path() + "/cache";
+  {
+    auto cache = ModelCache::forFile(cacheDir, model, "level=all\n");
+    CHECK(!cache.hasEntry());
+    store(cache);
+    CHECK(cache.hasEntry());
+  }
+  auto cache = ModelCache::forFile(cacheDir, model, "level=all\n");
+  CHECK(cache.hasEntry());
+  cache.discard();
+  CHECK(!cache.hasEntry());
+}
+
+void testOptionsKeptSideBySide() {
+  TempDirectory root;
+  auto model = root.path() + "/model.onnx";
+  write(model, "model");
+  auto cacheDir = root.path() + "/cache";
+  auto basic = ModelCache::forFile(cacheDir, model, "level=basic\n");
+  auto all = ModelCache::forFile(cacheDir, model, "level=all\n");
+  CHECK(basic.entryPath() != all.entryPath());
+  store(basic);
+  store(all);
+  CHECK(basic.hasEntry());
+  CHECK(all.hasEntry());
+  CHECK(countEntries(cacheDir) == 2);
+}
+
+void testChangedModelReplacesEntries() {
+  TempDirectory root;
+  auto model = root.path() + "/model.onnx";
+  write(model, "model");
+  setModifiedTime(model, 1000);
+  auto cacheDir = root.path() + "/cache";
+  auto basic = ModelCache::forFile(cacheDir, model, "level=basic\n");
+  auto all = ModelCache::forFile(cacheDir, model, "level=all\n");
+  store(basic);
+  store(all);
+
+  // Same path, new contents.
+  write(model, "updated model");
+  setModifiedTime(model, 2000);
+  auto updated = ModelCache::forFile(cacheDir, model, "level=all\n");
+  CHECK(updated.entryPath() != all.entryPath());
+  CHECK(!updated.hasEntry());
+  store(updated);
+  CHECK(updated.hasEntry());
+  CHECK(!basic.hasEntry());
+  CHECK(!all.hasEntry());
+  CHECK(countEntries(cacheDir) == 1);
+}
+
+void testOtherModelsUntouched() {
+  TempDirectory root;
+  auto first = root.path() + "/first.onnx";
+  auto second = root.path() + "/second.onnx";
+  write(first, "first");
+  write(second, "second");
+  auto cacheDir = root.path() + "/cache";
+  auto firstCache = ModelCache::forFile(cacheDir, first, "");
+  auto secondCache = ModelCache::forFile(cacheDir, second, "");
+  store(firstCache);
+  store(secondCache);
+  CHECK(firstCache.hasEntry());
+  CHECK(secondCache.hasEntry());
+}
+
+void testBuffers() {
+  TempDirectory root;
+  auto cacheDir = root.path() + "/cache";
+  auto model = sha256Hex("model");
+  auto cache = ModelCache::forBuffer(cacheDir, model, "");
+  store(cache);
+  CHECK(ModelCache::forBuffer(cacheDir, model, "").hasEntry());
+  CHECK(!ModelCache::forBuffer(cacheDir, sha256Hex("other"), "").hasEntry());
+}
+
+} // namespace
+
+int main() {
+  testHitAfterCommit();
+  testOptionsKeptSideBySide();
+  testChangedModelReplacesEntries();
+  testOtherModelsUntouched();
+  testBuffers();
+  return TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+#include "Check.h"
+#include "ProfileSummary.h"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+// Shaped like ORT's output: fence events around kernels, nested args the
+// summary skips, and a session event for each run.
+const char *const kProfile = R"([
+{"cat" : "Session","pid" :1,"tid" :1,"dur" :5,"ts" :1,"ph" : "X","name" :"model_loading_uri","args" : {}},
+{"cat" : "Node","pid" :1,"tid" :1,"dur" :0,"ts" :10,"ph" : "X","name" :"conv1_fence_before","args" : {"op_name" : "Conv"}},
+{"cat" : "Node","pid" :1,"tid" :1,"dur" :120,"ts" :11,"ph" : "X","name" :"conv1_kernel_time","args" : {"op_name" : "Conv","provider" : "CPUExecutionProvider","thread_scheduling_stats" : {"main_thread" : {"block_size": [1,2]}},"input_type_shape" : [{"float":[1,3,224,224]}]}},
+{"cat" : "Node","pid" :1,"tid" :1,"dur" :30,"ts" :200,"ph" : "X","name" :"relu_kernel_time","args" : {"op_name" : "Relu","provider" : "XnnpackExecutionProvider"}},
+{"cat" : "Session","pid" :1,"tid" :1,"dur" :300,"ts" :9,"ph" : "X","name" :"model_run","args" : {}},
+{"cat" : "Node","pid" :1,"tid" :1,"dur" :100,"ts" :400,"ph" : "X","name" :"conv1_kernel_time","args" : {"op_name" : "Conv","provider" : "CPUExecutionProvider"}},
+{"cat" : "Node","pid" :1,"tid" :1,"dur" :100,"ts" :450,"ph" : "X","name" :"conv2_kernel_time","args" : {"op_name" : "Conv","provider" : "CPUExecutionProvider","x":true,"y":null,"z":-1.5e3,"s":"a\"b"}}
+]
+)";
+
+class TempFile {
+public:
+  explicit TempFile(const std::string &contents) {
+    char name[] = "/tmp/profile-XXXXXX";
+    int fd = mkstemp(name);
+    close(fd);
+    path_ = name;
+    std::ofstream(path_) << contents;
+  }
+
+  ~TempFile() { std::remove(path_.c_str()); }
+
+  const std::string &path() const { return path_; }
+
+private:
+  std::string path_;
+};
+
+template <typename Callback> bool throwsRuntimeError(Callback &&callback) {
+  try {
+    callback();
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+  return false;
+}
+
+void testSummary() {
+  TempFile file(kProfile);
+  auto summary = ProfileSummary::fromFile(file.path(), 0);
+  CHECK(summary.runs == 1);
+  CHECK(summary.runTotalUs == 300);
+
+  CHECK(summary.nodes.size() == 3);
+  if (summary.nodes.size() == 3) {
+    CHECK(summary.nodes[0].name == "conv1");
+    CHECK(summary.nodes[0].opType == "Conv");
+    CHECK(summary.nodes[0].provider == "CPUExecutionProvider");
+    CHECK(summary.nodes[0].count == 2);
+    CHECK(summary.nodes[0].totalUs == 220);
+    CHECK(summary.nodes[1].name == "conv2");
+    CHECK(summary.nodes[2].name == "relu");
+    CHECK(summary.nodes[2].totalUs == 30);
+  }
+
+  CHECK(summary.opTypes.size() == 2);
+  if (summary.opTypes.size() == 2) {
+    CHECK(summary.opTypes[0].opType == "Conv");
+    CHECK(summary.opTypes[0].count == 3);
+    CHECK(summary.opTypes[0].totalUs == 320);
+    CHECK((summary.opTypes[0].providers ==
+           std::vector<std::string>{"CPUExecutionProvider"}));
+    CHECK(summary.opTypes[1].opType == "Relu");
+    CHECK((summary.opTypes[1].providers ==
+           std::vector<std::string>{"XnnpackExecutionProvider"}));
+  }
+}
+
+void testWindow() {
+  TempFile file(kProfile);
+  auto summary = ProfileSummary::fromFile(file.path(), 300);
+  CHECK(summary.runs == 0);
+  CHECK(summary.nodes.size() == 2);
+  CHECK(summary.opTypes.size() == 1);
+  if (!summary.opTypes.empty()) {
+    CHECK(summary.opTypes[0].count == 2);
+    CHECK(summary.opTypes[0].totalUs == 200);
+  }
+}
+
+void testEmpty() {
+  TempFile file("[]");
+  auto summary = ProfileSummary::fromFile(file.path(), 0);
+  CHECK(summary.runs == 0);
+  CHECK(summary.nodes.empty());
+  CHECK(summary.opTypes.empty());
+}
+
+void testErrors() {
+  CHECK(throwsRuntimeError(
+      [] { ProfileSummary::fromFile("/nonexistent/profile.json", 0); }));
+  TempFile truncated(std::string(kProfile).substr(0, 200));
+  CHECK(throwsRuntimeError(
+      [&] { ProfileSummary::fromFile(truncated.path(), 0); }));
+}
+
+} // namespace
+
+int main() {
+  testSummary();
+  testWindow();
+  testEmpty();
+  testErrors();
+  return TEST_RESULT();
+}
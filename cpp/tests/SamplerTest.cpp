@@ -0,0 +1,94 @@
+#include "Check.h"
+#include "Sampler.h"
+#include <set>
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+// Softmax: 0.64, 0.23, 0.09, 0.03 and 0.01 for tokens 1, 3, 2, 4, 0.
+const std::vector<float> kLogits = {1, 5, 3, 4, 2};
+
+std::set<int64_t> drawn(const Sampler::Options &options, int draws = 2000) {
+  Sampler sampler(options);
+  std::set<int64_t> tokens;
+  for (int i = 0; i < draws; ++i) {
+    auto logits = kLogits;
+    tokens.insert(sampler.sample(logits.data(), logits.size(), {}));
+  }
+  return tokens;
+}
+
+void testGreedy() {
+  Sampler sampler({});
+  auto logits = kLogits;
+  CHECK(sampler.sample(logits.data(), logits.size(), {}) == 1);
+
+  Sampler::Options options;
+  options.doSample = true;
+  options.temperature = 0;
+  CHECK(drawn(options, 50) == std::set<int64_t>{1});
+}
+
+void testRepetitionPenalty() {
+  Sampler::Options options;
+  options.repetitionPenalty = 100;
+  Sampler sampler(options);
+  auto logits = kLogits;
+  // Repeats in the history are penalized once.
+  CHECK(sampler.sample(logits.data(), logits.size(), {1, 1, 1}) == 3);
+  CHECK(logits[1] == 5.0f / 100);
+}
+
+void testTopK() {
+  Sampler::Options options;
+  options.doSample = true;
+  options.topK = 2;
+  options.seed = 1;
+  CHECK((drawn(options) == std::set<int64_t>{1, 3}));
+}
+
+void testTopP() {
+  Sampler::Options options;
+  options.doSample = true;
+  options.topP = 0.7f;
+  options.seed = 1;
+  CHECK((drawn(options) == std::set<int64_t>{1, 3}));
+
+  // A p below the top token's probability keeps that token alone.
+  options.topP = 0.5f;
+  CHECK(drawn(options, 200) == std::set<int64_t>{1});
+}
+
+void testFullDistribution() {
+  Sampler::Options options;
+  options.doSample = true;
+  options.seed = 1;
+  CHECK(drawn(options, 20000).size() == kLogits.size());
+}
+
+void testSeed() {
+  Sampler::Options options;
+  options.doSample = true;
+  options.seed = 42;
+  Sampler a(options);
+  Sampler b(options);
+  for (int i = 0; i < 100; ++i) {
+    auto logitsA = kLogits;
+    auto logitsB = kLogits;
+    CHECK(a.sample(logitsA.data(), logitsA.size(), {}) ==
+          b.sample(logitsB.data(), logitsB.size(), {}));
+  }
+}
+
+} // namespace
+
+int main() {
+  testGreedy();
+  testRepetitionPenalty();
+  testTopK();
+  testTopP();
+  testFullDistribution();
+  testSeed();
+  return TEST_RESULT();
+}
@@ -0,0 +1,96 @@
+#include "Check.h"
+#include "SessionRegistry.h"
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+std::shared_ptr<Ort::Session> newSession() {
+  return std::make_shared<Ort::Session>();
+}
+
+void testAcquire() {
+  SessionRegistry registry;
+  CHECK(registry.acquire("a") == nullptr);
+  auto a = registry.insert("a", newSession(), 10);
+  CHECK(registry.acquire("a") == a);
+  CHECK(registry.acquire("b") == nullptr);
+}
+
+void testConcurrentLoadSharesFirst() {
+  SessionRegistry registry;
+  auto first = registry.insert("a", newSession(), 10);
+  auto second = registry.insert("a", newSession(), 10);
+  CHECK(second == first);
+  CHECK(registry.getStats().sessions == 1);
+  CHECK(registry.getStats().bytes == 10);
+}
+
+void testNoBudgetKeepsNothingIdle() {
+  SessionRegistry registry;
+  auto a = registry.insert("a", newSession(), 10);
+  // In use, so kept although over the budget of 0.
+  CHECK(registry.getStats().sessions == 1);
+  CHECK(registry.getStats().idleSessions == 0);
+  a.reset();
+  CHECK(registry.getStats().idleSessions == 1);
+  registry.trim();
+  CHECK(registry.getStats().sessions == 0);
+  CHECK(registry.getStats().bytes == 0);
+  CHECK(registry.acquire("a") == nullptr);
+}
+
+void testLeastRecentlyUsedEviction() {
+  SessionRegistry registry;
+  registry.setBudget(30);
+  registry.insert("a", newSession(), 10);
+  registry.insert("b", newSession(), 10);
+  registry.insert("c", newSession(), 10);
+  CHECK(registry.getStats().sessions == 3);
+  // Touch a, so b is now the least recently used.
+  registry.acquire("a");
+  registry.insert("d", newSession(), 10);
+  CHECK(registry.getStats().sessions == 3);
+  CHECK(registry.getStats().bytes == 30);
+  CHECK(registry.acquire("b") == nullptr);
+  CHECK(registry.acquire("a") != nullptr);
+  CHECK(registry.acquire("c") != nullptr);
+  CHECK(registry.acquire("d") != nullptr);
+}
+
+void testBusySessionsAreSkipped() {
+  SessionRegistry registry;
+  registry.setBudget(20);
+  auto a = registry.insert("a", newSession(), 10);
+  registry.insert("b", newSession(), 10);
+  // a is the oldest but in use, so b goes instead.
+  registry.insert("c", newSession(), 10);
+  CHECK(registry.acquire("a") == a);
+  CHECK(registry.acquire("b") == nullptr);
+  CHECK(registry.acquire("c") != nullptr);
+}
+
+void testShrinkingBudget() {
+  SessionRegistry registry;
+  registry.setBudget(100);
+  registry.insert("a", newSession(), 40);
+  registry.insert("b", newSession(), 40);
+  registry.setBudget(50);
+  auto stats = registry.getStats();
+  CHECK(stats.sessions == 1);
+  CHECK(stats.bytes == 40);
+  CHECK(stats.budget == 50);
+  CHECK(registry.acquire("b") != nullptr);
+}
+
+} // namespace
+
+int main() {
+  testAcquire();
+  testConcurrentLoadSharesFirst();
+  testNoBudgetKeepsNothingIdle();
+  testLeastRecentlyUsedEviction();
+  testBusySessionsAreSkipped();
+  testShrinkingBudget();
+  return TEST_RESULT();
+}
@@ -0,0 +1,116 @@
+#include "Check.h"
+#include "SessionStats.h"
+#include <thread>
+#include <vector>
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+// Bucket bounds are within 2^(1/8), about 9%, above the true value.
+bool closeAbove(double actual, double expected) {
+  return actual >= expected && actual <= expected * 1.0906;
+}
+
+void testEmpty() {
+  LatencyHistogram histogram;
+  CHECK(histogram.count() == 0);
+  CHECK(histogram.percentile(0.5) == 0);
+}
+
+void testPercentiles() {
+  LatencyHistogram histogram;
+  // 0.1ms .. 100ms in 0.1ms steps.
+  for (int i = 1; i <= 1000; ++i) {
+    histogram.record(i * 0.1);
+  }
+  CHECK(histogram.count() == 1000);
+  CHECK(closeAbove(histogram.percentile(0.5), 50));
+  CHECK(closeAbove(histogram.percentile(0.95), 95));
+  CHECK(closeAbove(histogram.percentile(0.99), 99));
+  CHECK(closeAbove(histogram.percentile(1), 100));
+  CHECK(histogram.percentile(0.5) <= histogram.percentile(0.95));
+}
+
+void testOutOfRange() {
+  LatencyHistogram histogram;
+  // Below 1us and past the last bucket are clamped, not dropped.
+  histogram.record(0.0001);
+  histogram.record(1e12);
+  CHECK(histogram.count() == 2);
+  CHECK(histogram.percentile(0.5) <= 0.001 * 1.0906);
+  CHECK(histogram.percentile(1) > 3600 * 1000);
+}
+
+void testConcurrentRecord() {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 1; i <= 1000; ++i) {
+        histogram.record(i * 0.1);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  CHECK(histogram.count() == 4000);
+  CHECK(closeAbove(histogram.percentile(0.5), 50));
+}
+
+void testReset() {
+  SessionStats stats;
+  stats.runMs.record(5);
+  stats.runs += 3;
+  stats.errors += 1;
+  stats.reset();
+  CHECK(stats.runMs.count() == 0);
+  CHECK(stats.runMs.percentile(0.5) == 0);
+  CHECK(stats.runs == 0);
+  CHECK(stats.errors == 0);
+}
+
+void testWindow() {
+  constexpr int64_t kSecond = 1'000'000'000;
+  LatencyHistogram histogram;
+  int64_t start = 1000 * kSecond;
+  for (int i = 0; i < 100; ++i) {
+    histogram.record(100, start);
+  }
+  histogram.record(1, start + 30 * kSecond);
+  CHECK(histogram.recentCount(start + 30 * kSecond) == 101);
+  CHECK(closeAbove(histogram.percentile(0.5, start + 30 * kSecond), 100));
+  // A minute on, only the later sample is left in the window.
+  CHECK(histogram.recentCount(start + 65 * kSecond) == 1);
+  CHECK(closeAbove(histogram.percentile(0.5, start + 65 * kSecond), 1));
+  CHECK(histogram.percentile(0.5, start + 120 * kSecond) == 0);
+  // Recycling a slice drops its old samples; count() keeps them.
+  histogram.record(1, start + 60 * kSecond);
+  CHECK(histogram.recentCount(start + 60 * kSecond) == 2);
+  CHECK(histogram.count() == 102);
+}
+
+void testRunsPerSecond() {
+  SessionStats stats;
+  for (int i = 0; i < 10; ++i) {
+    stats.runMs.record(1);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto rate = stats.runsPerSecond();
+  CHECK(rate > 0);
+  CHECK(rate <= 100);
+}
+
+} // namespace
+
+int main() {
+  testEmpty();
+  testPercentiles();
+  testOutOfRange();
+  testConcurrentRecord();
+  testReset();
+  testWindow();
+  testRunsPerSecond();
+  return TEST_RESULT();
+}
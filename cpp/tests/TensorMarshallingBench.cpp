@@ -0,0 +1,59 @@
+// Times the conversion of JS tensors to OrtValues, the per-input cost of
+// every run() and bindInput(). Built only when a JS runtime and ONNX Runtime
+// are available; see CMakeLists.txt.
+#include "Env.h"
+#include "TensorUtils.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <hermes/hermes.h>
+
+using namespace facebook::jsi;
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+// A transformer feed with past key/values easily reaches 20 inputs.
+constexpr int kInputCount = 20;
+
+const char *const kCreateFeeds = R"(
+globalThis.feeds = Array.from({length: 20}, (_, i) => i % 2 ?
+  {cpuData: new Float32Array(2 * 64), dims: [2, 64], type: 'float32'} :
+  {cpuData: new BigInt64Array(128), dims: [1, 128], type: 'int64'});
+)";
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+  auto runtime = facebook::hermes::makeHermesRuntime();
+  auto &rt = *runtime;
+  rt.evaluateJavaScript(std::make_shared<StringBuffer>(kCreateFeeds),
+                        "feeds.js");
+  auto feeds = rt.global().getPropertyAsObject(rt, "feeds").asArray(rt);
+  std::vector<Object> tensors;
+  for (int i = 0; i < kInputCount; ++i) {
+    tensors.push_back(feeds.getValueAtIndex(rt, i).asObject(rt));
+  }
+
+  Env env(nullptr);
+  auto memoryInfo =
+      Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  // Warms the per-runtime caches.
+  for (auto &tensor : tensors) {
+    TensorUtils::createOrtValueFromJSTensor(rt, env, tensor, memoryInfo);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (auto &tensor : tensors) {
+      TensorUtils::createOrtValueFromJSTensor(rt, env, tensor, memoryInfo);
+    }
+  }
+  auto elapsedUs = std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::printf("%d x %d tensors: %.3f us per tensor\n", iterations,
+              kInputCount, elapsedUs / (iterations * kInputCount));
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include "Check.h"
+#include "TraceBuffer.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+const char *const kNames[] = {"s0",  "s1",  "s2",  "s3",  "s4",  "s5",  "s6",
+                              "s7",  "s8",  "s9",  "s10", "s11", "s12", "s13",
+                              "s14", "s15", "s16", "s17", "s18", "s19"};
+
+size_t countOf(const std::string &text, const std::string &needle) {
+  size_t count = 0;
+  for (auto pos = text.find(needle); pos != std::string::npos;
+       pos = text.find(needle, pos + needle.size())) {
+    ++count;
+  }
+  return count;
+}
+
+bool hasSpan(const std::string &json, const char *name) {
+  return json.find(std::string("\"name\":\"") + name + "\"") !=
+         std::string::npos;
+}
+
+void record(TraceBuffer &trace, const char *name,
+            TraceBuffer::Kind kind = TraceBuffer::Kind::Complete) {
+  auto now = TraceBuffer::Clock::now();
+  trace.record(name, now, now + std::chrono::microseconds(5), 1, kind);
+}
+
+void testDisabled() {
+  TraceBuffer trace;
+  record(trace, "off");
+  { TraceSpan span(trace, "scoped"); }
+  CHECK(!trace.enabled());
+  CHECK(countOf(trace.toJson(), "\"ph\":\"X\"") == 0);
+}
+
+void testWraparound() {
+  TraceBuffer trace;
+  trace.start(8);
+  for (auto name : kNames) {
+    record(trace, name);
+  }
+  auto json = trace.toJson();
+  // Only the newest capacity spans survive.
+  CHECK(countOf(json, "\"ph\":\"X\"") == 8);
+  for (size_t i = 0; i < 20; ++i) {
+    CHECK(hasSpan(json, kNames[i]) == (i >= 12));
+  }
+
+  // A later start() keeps the original capacity.
+  trace.stop();
+  record(trace, "stopped");
+  trace.start(1024);
+  for (auto name : kNames) {
+    record(trace, name);
+  }
+  json = trace.toJson();
+  CHECK(!hasSpan(json, "stopped"));
+  CHECK(countOf(json, "\"ph\":\"X\"") == 8);
+}
+
+void testClear() {
+  TraceBuffer trace;
+  trace.start(8);
+  for (size_t i = 0; i < 5; ++i) {
+    record(trace, kNames[i]);
+  }
+  trace.clear();
+  CHECK(countOf(trace.toJson(), "\"ph\":\"X\"") == 0);
+  record(trace, "after");
+  auto json = trace.toJson();
+  CHECK(countOf(json, "\"ph\":\"X\"") == 1);
+  CHECK(hasSpan(json, "after"));
+}
+
+void testAsyncSpans() {
+  TraceBuffer trace;
+  trace.start(8);
+  record(trace, "queue", TraceBuffer::Kind::Async);
+  auto json = trace.toJson();
+  CHECK(countOf(json, "\"ph\":\"b\"") == 1);
+  CHECK(countOf(json, "\"ph\":\"e\"") == 1);
+  CHECK(countOf(json, "\"ph\":\"X\"") == 0);
+  CHECK(countOf(json, "\"name\":\"thread_name\"") == 1);
+}
+
+// Readers never see a torn slot while writers wrap the ring underneath.
+void testConcurrentWriters() {
+  TraceBuffer trace;
+  trace.start(64);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&] {
+      for (int i = 0; i < 5000; ++i) {
+        TraceSpan span(trace, "work", i);
+      }
+    });
+  }
+  for (int i = 0; i < 20; ++i) {
+    auto json = trace.toJson();
+    CHECK(countOf(json, "\"ph\":\"X\"") <= 64);
+    CHECK(countOf(json, "\"ph\":\"X\"") ==
+          countOf(json, "\"name\":\"work\""));
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  CHECK(countOf(trace.toJson(), "\"ph\":\"X\"") == 64);
+}
+
+} // namespace
+
+int main() {
+  testDisabled();
+  testWraparound();
+  testClear();
+  testAsyncSpans();
+  testConcurrentWriters();
+  return TEST_RESULT();
+}
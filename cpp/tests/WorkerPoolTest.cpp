@@ -0,0 +1,172 @@
+#include "Check.h"
+#include "WorkerPool.h"
+#include <stdexcept>
+
+using namespace onnxruntimereactnativejsi;
+
+namespace {
+
+void waitForIdle(WorkerPool &pool) {
+  while (true) {
+    auto stats = pool.getStats();
+    if (stats.completed == stats.submitted) {
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// Holds a single-thread pool busy until released, so tasks submitted
+// meanwhile are all queued when it starts picking them.
+class Gate {
+public:
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return open_; });
+  }
+
+  void open() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = true;
+    }
+    cv_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool open_ = false;
+};
+
+void testPriorityOrder() {
+  WorkerPool pool(1);
+  Gate gate;
+  std::mutex mutex;
+  std::vector<int> order;
+  auto push = [&](int value) {
+    return [&, value] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(value);
+    };
+  };
+  pool.submit([&] { gate.wait(); });
+  pool.submit(push(20), WorkerPool::Priority::Low);
+  pool.submit(push(10), WorkerPool::Priority::Normal);
+  pool.submit(push(0), WorkerPool::Priority::High);
+  pool.submit(push(21), WorkerPool::Priority::Low);
+  pool.submit(push(1), WorkerPool::Priority::High);
+  gate.open();
+  waitForIdle(pool);
+  CHECK((order == std::vector<int>{0, 1, 10, 20, 21}));
+}
+
+void testSerialQueueOrder() {
+  WorkerPool pool(4);
+  auto queue = std::make_shared<WorkerPool::SerialQueue>();
+  std::mutex mutex;
+  std::vector<int> order;
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  for (int i = 0; i < 200; ++i) {
+    pool.submit(queue, [&, i] {
+      int now = ++running;
+      if (now > maxRunning) {
+        maxRunning = now;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(i);
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(20));
+      --running;
+      // A throwing task must not stall the queue behind it.
+      if (i == 5) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  }
+  waitForIdle(pool);
+  CHECK(maxRunning == 1);
+  CHECK(order.size() == 200);
+  for (size_t i = 0; i < order.size(); ++i) {
+    CHECK(order[i] == static_cast<int>(i));
+  }
+}
+
+void testSerialQueuePriority() {
+  WorkerPool pool(1);
+  Gate gate;
+  auto queue = std::make_shared<WorkerPool::SerialQueue>();
+  std::mutex mutex;
+  std::vector<int> order;
+  auto push = [&](int value) {
+    return [&, value] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(value);
+    };
+  };
+  pool.submit(queue, [&] { gate.wait(); });
+  pool.submit(queue, push(20), WorkerPool::Priority::Low);
+  pool.submit(queue, push(10), WorkerPool::Priority::Normal);
+  pool.submit(queue, push(0), WorkerPool::Priority::High);
+  pool.submit(queue, push(21), WorkerPool::Priority::Low);
+  pool.submit(queue, push(1), WorkerPool::Priority::High);
+  gate.open();
+  waitForIdle(pool);
+  CHECK((order == std::vector<int>{0, 1, 10, 20, 21}));
+}
+
+// Tasks of one queue never overlap, whatever their priorities, while
+// queues and plain tasks share the pool.
+void testSerialQueuesUnderContention() {
+  constexpr int kQueues = 3;
+  WorkerPool pool(4);
+  std::vector<std::shared_ptr<WorkerPool::SerialQueue>> queues;
+  std::atomic<int> running[kQueues] = {};
+  std::atomic<int> overlaps{0};
+  std::atomic<int> done{0};
+  for (int i = 0; i < kQueues; ++i) {
+    queues.push_back(std::make_shared<WorkerPool::SerialQueue>());
+  }
+  std::vector<std::thread> submitters;
+  for (int t = 0; t < 3; ++t) {
+    submitters.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        int index = (i + t) % kQueues;
+        auto priority = static_cast<WorkerPool::Priority>((i * 7 + t) % 3);
+        pool.submit(
+            queues[index],
+            [&, index] {
+              if (++running[index] != 1) {
+                ++overlaps;
+              }
+              std::this_thread::yield();
+              --running[index];
+              ++done;
+            },
+            priority);
+        if (i % 7 == 0) {
+          pool.submit([&] { ++done; }, priority);
+        }
+      }
+    });
+  }
+  for (auto &submitter : submitters) {
+    submitter.join();
+  }
+  waitForIdle(pool);
+  CHECK(overlaps == 0);
+  CHECK(static_cast<uint64_t>(done) == pool.getStats().submitted);
+  CHECK(pool.pending() == 0);
+}
+
+} // namespace
+
+int main() {
+  testPriorityOrder();
+  testSerialQueueOrder();
+  testSerialQueuePriority();
+  testSerialQueuesUnderContention();
+  return TEST_RESULT();
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Stand-in for ONNX Runtime's C++ API in tests of code that only passes
+// sessions around or asks for the runtime's version.
+namespace Ort {
+struct Session {};
+} // namespace Ort
+
+struct OrtApiBase {
+  const char *(*GetVersionString)();
+};
+
+inline const OrtApiBase *OrtGetApiBase() {
+  static const OrtApiBase base{[]() { return "test"; }};
+  return &base;
+}
@@ -8,6 +8,107 @@ export interface SupportedBackend {
   name: string;
 }
 
+export interface JsiEnvFlags {
+  /**
+   * Number of native worker threads shared by all sessions. Only takes effect
+   * before the first session is created.
+   */
+  workerPoolSize?: number;
+  /**
+   * Runs waiting in the worker pool beyond which new runs are rejected
+   * immediately. High priority runs are never rejected. 0 means unbounded.
+   */
+  maxQueueDepth?: number;
+  /**
+   * Creates ORT thread pools shared by every session loaded with
+   * `useGlobalThreadPools`. Only takes effect before the first session is
+   * created.
+   */
+  globalThreadPools?: GlobalThreadPoolOptions;
+  /**
+   * Bytes of loaded models to keep. Sessions nobody uses any more stay
+   * loaded for reuse until the total exceeds this, then the least recently
+   * used are released. Defaults to 0: unused sessions are released at once.
+   */
+  sessionMemoryBudget?: number;
+  /**
+   * Registers one CPU arena with the ORT Env for every session loaded with
+   * `useSharedArena`. Only takes effect before the first session is created.
+   */
+  sharedCpuArena?: SharedArenaOptions;
+}
+
+/** Unset fields keep ORT's defaults. */
+export interface SharedArenaOptions {
+  /** Upper bound of the arena in bytes. 0 means no limit. */
+  maxMemory?: number;
+  /** How the arena grows when it runs out. Defaults to 'nextPowerOfTwo'. */
+  extendStrategy?: 'nextPowerOfTwo' | 'sameAsRequested';
+  initialChunkSizeBytes?: number;
+  /** Unused bytes a chunk may hold before it is split. */
+  maxDeadBytesPerChunk?: number;
+}
+
+export interface GlobalThreadPoolOptions {
+  /** 0 lets ORT use one thread per physical core. Defaults to 0. */
+  intraOpNumThreads?: number;
+  /** Defaults to 0. */
+  interOpNumThreads?: number;
+  /** Whether idle threads spin before sleeping. Defaults to true. */
+  allowSpinning?: boolean;
+  /**
+   * Processor affinity of the intra-op threads, in the format of ORT's
+   * `session.intra_op_thread_affinities`.
+   */
+  intraOpThreadAffinity?: string;
+}
+
+export interface SessionRegistryStats {
+  sessions: number;
+  /** Sessions kept for reuse that no InferenceSession currently uses. */
+  idleSessions: number;
+  /** Estimated from the size of each model and its external data. */
+  bytes: number;
+  budget: number;
+}
+
+export interface TracingOptions {
+  /**
+   * Spans kept before the oldest are overwritten; only the first
+   * `startTracing()` sizes the buffer. Defaults to 16384.
+   */
+  capacity?: number;
+}
+
+export interface ExportTraceOptions {
+  /**
+   * A profile kept by `stopProfiling({ keepFile: true })`, merged into the
+   * trace with binding spans aligned to its clock.
+   */
+  profile?: { file: string; startTimeUs: number };
+  /** Drops the exported spans from the buffer. */
+  clear?: boolean;
+}
+
+export interface ThreadStats {
+  globalThreadPools: boolean;
+  /** As configured; only set with global thread pools. */
+  intraOpNumThreads?: number;
+  interOpNumThreads?: number;
+  workerPoolSize: number;
+  /** Threads in the whole process, or -1 if unknown. */
+  processThreads: number;
+}
+
+export interface WorkerPoolStats {
+  size: number;
+  queueDepth: number;
+  activeWorkers: number;
+  submitted: number;
+  completed: number;
+  utilization: number;
+}
+
 export interface ValueMetadata {
   name: string;
   isTensor: boolean;
@@ -22,26 +123,345 @@ type ReturnType = SessionHandler.ReturnType;
 type SessionOptions = InferenceSession.SessionOptions;
 type RunOptions = InferenceSession.RunOptions;
 
+/**
+ * Session options understood by this backend on top of `onnxruntime-common`'s.
+ */
+export interface NativeSessionOptions extends SessionOptions {
+  /**
+   * Directory caching optimized models. The first load of a model writes its
+   * optimized graph there; later loads with the same model, ORT version and
+   * graph-shaping options use it and skip optimization. Only used for ONNX
+   * models without `externalData` that run on the CPU provider.
+   */
+  optimizedModelCacheDir?: string;
+  /**
+   * Names registered with `registerSharedInitializer` to use in place of the
+   * model's own initializers, so sessions share one copy of those weights.
+   */
+  sharedInitializers?: string[];
+  /**
+   * Store prepacked weights in a container shared by all sessions that set
+   * this, so sessions over the same weights prepack them once.
+   */
+  sharePrepackedWeights?: boolean;
+  /**
+   * Run on the Env's global thread pools instead of starting per-session
+   * ones. Requires `jsiEnv.globalThreadPools`.
+   */
+  useGlobalThreadPools?: boolean;
+  /**
+   * Allocate from the Env's shared CPU arena instead of a per-session one.
+   * Requires `jsiEnv.sharedCpuArena`.
+   */
+  useSharedArena?: boolean;
+  /**
+   * Loading a model already loaded with the same options shares its native
+   * session. Defaults to true; sessions with profiling, `sharedInitializers`
+   * or in-memory `externalData` are never shared.
+   */
+  shareSession?: boolean;
+  /**
+   * Run the model on all-zero inputs after loading, so the first real run
+   * doesn't pay for arena growth and kernel setup. `true` runs it once.
+   */
+  warmup?: boolean | number | WarmupOptions;
+}
+
+export interface WarmupOptions {
+  /** Defaults to 1. */
+  iterations?: number;
+  /** Sizes of symbolic dimensions by name. Others default to 1. */
+  dims?: { [name: string]: number };
+}
+
+/**
+ * Run options understood by this backend on top of `onnxruntime-common`'s.
+ * They are honored through either API. Results of the native APIs carry a
+ * non-enumerable `queueWaitMs`: the time the run waited before starting.
+ */
+export interface NativeRunOptions extends RunOptions {
+  /** Queued runs start in priority order. Defaults to 'normal'. */
+  priority?: 'high' | 'normal' | 'low';
+  /** Reject the run without starting it if it waits longer than this. */
+  deadlineMs?: number;
+  /**
+   * Attach a non-enumerable `timings` (`RunTimings`) to the result of the
+   * native APIs.
+   */
+  timings?: boolean;
+  /**
+   * Return the CPU arena's unused memory to the system after the run, e.g.
+   * after an unusually large input.
+   */
+  shrinkArena?: boolean;
+}
+
+/** CPU arena counters as reported by ORT, in bytes where applicable. */
+export interface AllocatorStats {
+  limit?: number;
+  inUse?: number;
+  /** Memory the arena holds, in use or not. */
+  totalAllocated?: number;
+  maxInUse?: number;
+  numAllocs?: number;
+  numReserves?: number;
+  numArenaExtensions?: number;
+  numArenaShrinkages?: number;
+  maxAllocSize?: number;
+}
+
+export interface SessionMemoryReport {
+  /** Null when the session has no arena, e.g. with `enableCpuMemArena` off. */
+  arena: AllocatorStats | null;
+  /** Whether `arena` is the Env's shared arena. */
+  sharedArena: boolean;
+}
+
+export interface MemoryReport {
+  /** Resident memory of the whole process, or -1 if unknown. */
+  residentBytes: number;
+  /** Live sessions, including idle ones kept for sharing. */
+  sessions: number;
+  /** Arena counters summed over those sessions, except the shared arena. */
+  arena: AllocatorStats | null;
+  /** The Env's shared arena, once a live session allocates from it. */
+  sharedArena: AllocatorStats | null;
+  sessionRegistryBytes: number;
+  sharedInitializerBytes: number;
+}
+
+/**
+ * Percentiles cover roughly the last minute and are accurate to about 9%.
+ */
+export interface LatencyStats {
+  /** Samples since the session was created or `resetStats()` was called. */
+  count: number;
+  p50: number;
+  p95: number;
+  p99: number;
+}
+
+export interface SessionStats {
+  runs: number;
+  /** Over roughly the last minute. */
+  runsPerSecond: number;
+  errors: number;
+  /** Runs rejected without running because their deadline passed. */
+  cancels: number;
+  /** Tensor bytes passed between JS and native memory. */
+  bytesIn: number;
+  bytesOut: number;
+  queueMs: LatencyStats;
+  runMs: LatencyStats;
+  /** Converting feeds, fetches and results on the JS thread. */
+  marshalMs: LatencyStats;
+}
+
+export interface ProfileNodeStats {
+  name: string;
+  opType: string;
+  /** Execution provider the node ran on. */
+  provider: string;
+  count: number;
+  totalMs: number;
+  meanMs: number;
+}
+
+export interface ProfileOpTypeStats {
+  opType: string;
+  providers: string[];
+  count: number;
+  totalMs: number;
+  meanMs: number;
+}
+
+/** Kernel time within a profiling window; lists are sorted by `totalMs`. */
+export interface ProfileReport {
+  runs: number;
+  runTotalMs: number;
+  /** When profiling started, for `exportTrace()`. */
+  startTimeUs: number;
+  nodes: ProfileNodeStats[];
+  opTypes: ProfileOpTypeStats[];
+  /** Path of the raw ORT profile, if `keepFile` was set. */
+  file?: string;
+}
+
+/** Where a run spent its time, in milliseconds. */
+export interface RunTimings {
+  /** Converting feeds and fetches on the JS thread. */
+  marshalMs: number;
+  /** Waiting for a worker thread. */
+  queueMs: number;
+  /** Inside ORT's Run. */
+  runMs: number;
+  /** On the worker thread, `runMs` included. */
+  executeMs: number;
+  /** Waiting for the JS thread after the run finished. */
+  jsWaitMs: number;
+  /** Converting outputs on the JS thread. */
+  outputMs: number;
+  /** From the call until the result was ready. */
+  totalMs: number;
+}
+
+/**
+ * A tensor kept in native memory. Returned by `InferenceSessionImpl.run` for
+ * fetches set to `'native'` and accepted as a feed, so its data never
+ * crosses into JS unless `data` is read.
+ */
+export interface OrtValueImpl {
+  readonly type: Tensor.Type;
+  readonly dims: readonly number[];
+  readonly size: number;
+  /**
+   * A TypedArray over the native memory, created on first read. It stays
+   * valid after `dispose()`.
+   */
+  readonly data: Tensor.DataType;
+  readonly isDisposed: boolean;
+
+  toTensor(): Tensor;
+
+  dispose(): void;
+}
+
+export type NativeFeedsType = {
+  [name: string]: FeedsType[string] | OrtValueImpl;
+};
+export type NativeFetchesType = {
+  [name: string]: FetchesType[string] | 'native';
+};
+export type NativeReturnType = {
+  [name: string]: ReturnType[string] | OrtValueImpl;
+};
+
+export interface IoBindingImpl {
+  bindInput(name: string, tensor: Tensor): void;
+  /**
+   * Binds a preallocated tensor, or lets ORT allocate the output when no
+   * tensor is given.
+   */
+  bindOutput(name: string, tensor?: Tensor): void;
+  clearBoundInputs(): void;
+  clearBoundOutputs(): void;
+
+  run(options?: NativeRunOptions): Promise<ReturnType>;
+
+  dispose(): void;
+}
+
+export interface GenerateOptions {
+  /** Defaults to 128. */
+  maxNewTokens?: number;
+  /**
+   * Capacity of the native KV cache in tokens, prompt included. Defaults to
+   * the prompt length plus `maxNewTokens`.
+   */
+  maxLength?: number;
+  /** Sample from the distribution; greedy decoding otherwise. */
+  doSample?: boolean;
+  temperature?: number;
+  topK?: number;
+  topP?: number;
+  repetitionPenalty?: number;
+  eosTokenId?: number | number[];
+  seed?: number;
+  runOptions?: NativeRunOptions;
+}
+
+export interface BatchingOptions {
+  /** Run as soon as this many rows are queued. Defaults to 8. */
+  maxBatchSize?: number;
+  /** How long the first queued request waits for others. Defaults to 0. */
+  windowMs?: number;
+  /** Dimension holding the batch in every input and output. Defaults to 0. */
+  axis?: number;
+}
+
 export interface InferenceSessionImpl {
-  loadModel(modelPath: string, options: SessionOptions): Promise<void>;
+  loadModel(modelPath: string, options: NativeSessionOptions): Promise<void>;
   loadModel(
     buffer: ArrayBuffer,
     byteOffset: number,
     byteLength: number,
-    options: SessionOptions
+    options: NativeSessionOptions
   ): Promise<void>;
 
-  readonly inputMetadata: ValueMetadata[];
-  readonly outputMetadata: ValueMetadata[];
+  /** Computed once at load and frozen; repeated reads return the same array. */
+  readonly inputMetadata: readonly ValueMetadata[];
+  readonly outputMetadata: readonly ValueMetadata[];
+  /** Latency in ms of each warm-up run at load, if `warmup` was set. */
+  readonly warmupMs: number[];
+  /**
+   * Aggregates of all runs, IoBinding runs included. Counters cover every
+   * run since the session was created or `resetStats()` was called; latency
+   * percentiles and `runsPerSecond` cover roughly the last minute.
+   */
+  readonly stats: SessionStats;
+
+  resetStats(): void;
+
+  getMemoryReport(): SessionMemoryReport;
+
+  /**
+   * Checks feed names, types and fixed dimensions against the input metadata
+   * and throws on the first mismatch. `run()` performs the same check.
+   */
+  validateFeeds(feeds: NativeFeedsType): void;
 
+  /** Fetches set to `'native'` are returned as `OrtValueImpl`. */
   run(
-    feeds: FeedsType,
-    fetches: FetchesType,
-    options: RunOptions
-  ): Promise<ReturnType>;
+    feeds: NativeFeedsType,
+    fetches: NativeFetchesType,
+    options?: NativeRunOptions
+  ): Promise<NativeReturnType>;
+
+  /**
+   * Runs a decoder-only model autoregressively in native code, keeping the
+   * KV cache native between steps. Resolves with the generated token ids.
+   * `onToken` is called on the JS thread for each token; returning `false`
+   * stops generation. `dispose()` aborts it.
+   */
+  generate(
+    inputIds: readonly number[],
+    options?: GenerateOptions,
+    onToken?: (token: number) => boolean | void
+  ): Promise<number[]>;
+
+  /**
+   * Coalesces concurrent `run()` calls that share feed names, types and
+   * non-batch dimensions into one native run. Only calls without run options
+   * whose fetches are all ORT-allocated are batched, and only when the model
+   * gives every input and fetched output the same symbolic dimension at
+   * `axis`. Pass `null` to disable.
+   */
+  setBatching(options: BatchingOptions | null): void;
 
   endProfiling(): void;
 
+  /**
+   * Starts the window summarized by `stopProfiling()`. Requires the model to
+   * be loaded with `enableProfiling`; without a call, the window starts at
+   * load.
+   */
+  startProfiling(): void;
+
+  /**
+   * Ends the session's profile after queued runs finish and resolves with
+   * per-node and per-op-type kernel times of the window. The profile file is
+   * deleted unless `keepFile` is set. ORT writes one profile per session, so
+   * profiling cannot be restarted afterwards.
+   */
+  stopProfiling(options?: { keepFile?: boolean }): Promise<ProfileReport>;
+
+  createBinding(): IoBindingImpl;
+
+  /**
+   * Releases the session. Pending `run()` and `generate()` calls are
+   * rejected with "Aborted"; running ones are terminated. A `loadModel()` in
+   * progress finishes loading, then rejects and releases what it loaded.
+   */
   dispose(): void;
 }
 
@@ -50,7 +470,39 @@ export declare interface OrtApi {
 
   listSupportedBackends(): SupportedBackend[];
 
-  initOrtOnce(logLevel: number, tensorConstructor: typeof Tensor): void;
+  initOrtOnce(
+    logLevel: number,
+    tensorConstructor: typeof Tensor,
+    options?: JsiEnvFlags
+  ): void;
+
+  getWorkerPoolStats(): WorkerPoolStats;
+
+  getThreadStats(): ThreadStats;
+
+  getSessionRegistryStats(): SessionRegistryStats;
+
+  getMemoryReport(): MemoryReport;
+
+  /**
+   * Makes a tensor available to sessions as an initializer by name. Tensors
+   * are copied to native memory; native tensors are shared as they are.
+   */
+  registerSharedInitializer(name: string, tensor: Tensor | OrtValueImpl): void;
+  /** Sessions already using the initializer keep it until they are released. */
+  unregisterSharedInitializer(name: string): void;
+
+  /**
+   * Records binding spans (promise setup, queueing, execution, JS thread
+   * hops and tensor conversion) with their thread ids into a native ring
+   * buffer.
+   */
+  startTracing(options?: TracingOptions): void;
+
+  stopTracing(): void;
+
+  /** Chrome trace event JSON, loadable in Perfetto or chrome://tracing. */
+  exportTrace(options?: ExportTraceOptions): string;
 
   version: string;
 }
@@ -5,9 +5,15 @@ import type {
   SessionHandler,
 } from 'onnxruntime-common';
 import { env, Tensor } from 'onnxruntime-common';
-import type { InferenceSessionImpl, ValueMetadata } from './api';
+import type {
+  InferenceSessionImpl,
+  JsiEnvFlags,
+  ValueMetadata,
+} from './api';
 import { OrtApi } from './binding';
 
+export const jsiEnv: JsiEnvFlags = {};
+
 const dataTypeStrings = [
   undefined, // 0
   'float32',
@@ -77,6 +83,7 @@ const fillNamesAndMetadata = (
 
 class OnnxruntimeSessionHandler implements InferenceSessionHandler {
   #inferenceSession: InferenceSessionImpl;
+  #profilingEnabled: boolean;
 
   static #initialized = false;
 
@@ -87,9 +94,11 @@ class OnnxruntimeSessionHandler implements InferenceSessionHandler {
       outputNames: string[];
       inputMetadata: InferenceSession.ValueMetadata[];
       outputMetadata: InferenceSession.ValueMetadata[];
+      profilingEnabled: boolean;
     }
   ) {
     this.#inferenceSession = session;
+    this.#profilingEnabled = info.profilingEnabled;
     this.inputNames = info.inputNames;
     this.outputNames = info.outputNames;
     this.inputMetadata = info.inputMetadata;
@@ -129,7 +138,7 @@ class OnnxruntimeSessionHandler implements InferenceSessionHandler {
             throw new Error(`Unsupported log level: ${env.logLevel}`);
         }
       }
-      OrtApi.initOrtOnce(logLevel, Tensor);
+      OrtApi.initOrtOnce(logLevel, Tensor, jsiEnv);
     }
 
     const session = OrtApi.createInferenceSession();
@@ -156,6 +165,7 @@ class OnnxruntimeSessionHandler implements InferenceSessionHandler {
       outputNames,
       inputMetadata,
       outputMetadata,
+      profilingEnabled: !!options.enableProfiling,
     });
   }
 
@@ -163,6 +173,10 @@ class OnnxruntimeSessionHandler implements InferenceSessionHandler {
     this.#inferenceSession.dispose();
   }
 
+  get nativeSession(): InferenceSessionImpl {
+    return this.#inferenceSession;
+  }
+
   readonly inputNames: string[];
   readonly outputNames: string[];
 
@@ -170,9 +184,11 @@ class OnnxruntimeSessionHandler implements InferenceSessionHandler {
   readonly outputMetadata: InferenceSession.ValueMetadata[];
 
   startProfiling(): void {
-    // startProfiling is a no-op.
-    //
-    // if sessionOptions.enableProfiling is true, profiling will be enabled when the model is loaded.
+    // ORT can only profile from session creation, so profiling must be
+    // enabled at load; without it this stays a no-op as before.
+    if (this.#profilingEnabled) {
+      this.#inferenceSession.startProfiling();
+    }
   }
   endProfiling(): void {
     this.#inferenceSession.endProfiling();
@@ -183,7 +199,13 @@ class OnnxruntimeSessionHandler implements InferenceSessionHandler {
     fetches: SessionHandler.FetchesType,
     options: RunOptions
   ): Promise<SessionHandler.ReturnType> {
-    return await this.#inferenceSession.run(feeds, fetches, options);
+    // Only native fetches yield OrtValueImpl, and onnxruntime-common never
+    // passes those.
+    return (await this.#inferenceSession.run(
+      feeds,
+      fetches,
+      options
+    )) as SessionHandler.ReturnType;
   }
 }
 
@@ -201,4 +223,27 @@ class OnnxruntimeBackend implements Backend {
 }
 
 export const onnxruntimeBackend = new OnnxruntimeBackend();
+
+/**
+ * Returns the native session behind an `InferenceSession` created by this
+ * backend, for the APIs `onnxruntime-common` does not expose.
+ */
+export const getNativeSession = (
+  session: InferenceSession
+): InferenceSessionImpl => {
+  const handler = (session as unknown as { handler: unknown }).handler;
+  if (!(handler instanceof OnnxruntimeSessionHandler)) {
+    throw new Error('Session was not created by the JSI backend');
+  }
+  return handler.nativeSession;
+};
 export const listSupportedBackends = OrtApi.listSupportedBackends;
+export const getWorkerPoolStats = OrtApi.getWorkerPoolStats;
+export const getThreadStats = OrtApi.getThreadStats;
+export const getSessionRegistryStats = OrtApi.getSessionRegistryStats;
+export const getMemoryReport = OrtApi.getMemoryReport;
+export const registerSharedInitializer = OrtApi.registerSharedInitializer;
+export const unregisterSharedInitializer = OrtApi.unregisterSharedInitializer;
+export const startTracing = OrtApi.startTracing;
+export const stopTracing = OrtApi.stopTracing;
+export const exportTrace = OrtApi.exportTrace;
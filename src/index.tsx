@@ -1,8 +1,51 @@
 export * from 'onnxruntime-common';
-export { listSupportedBackends } from './backend';
+export {
+  listSupportedBackends,
+  getWorkerPoolStats,
+  getThreadStats,
+  getSessionRegistryStats,
+  getMemoryReport,
+  getNativeSession,
+  jsiEnv,
+  registerSharedInitializer,
+  unregisterSharedInitializer,
+  startTracing,
+  stopTracing,
+  exportTrace,
+} from './backend';
+export type {
+  AllocatorStats,
+  BatchingOptions,
+  ExportTraceOptions,
+  GenerateOptions,
+  GlobalThreadPoolOptions,
+  InferenceSessionImpl,
+  IoBindingImpl,
+  JsiEnvFlags,
+  LatencyStats,
+  MemoryReport,
+  NativeFeedsType,
+  NativeFetchesType,
+  NativeReturnType,
+  NativeRunOptions,
+  NativeSessionOptions,
+  OrtValueImpl,
+  ProfileNodeStats,
+  ProfileOpTypeStats,
+  ProfileReport,
+  RunTimings,
+  SessionMemoryReport,
+  SessionRegistryStats,
+  SharedArenaOptions,
+  SessionStats,
+  ThreadStats,
+  TracingOptions,
+  WarmupOptions,
+  WorkerPoolStats,
+} from './api';
 
 import { registerBackend, env } from 'onnxruntime-common';
-import { onnxruntimeBackend, listSupportedBackends } from './backend';
+import { onnxruntimeBackend, listSupportedBackends, jsiEnv } from './backend';
 import { OrtApi } from './binding';
 
 const backends = listSupportedBackends();
@@ -14,3 +57,8 @@ Object.defineProperty(env.versions, 'react-native', {
   value: OrtApi.version,
   enumerable: true,
 });
+
+Object.defineProperty(env, 'jsi', {
+  value: jsiEnv,
+  enumerable: true,
+});